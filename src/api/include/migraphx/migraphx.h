@@ -548,6 +548,12 @@ migraphx_compile_options_set_fast_math(migraphx_compile_options_t compile_option
 MIGRAPHX_C_EXPORT migraphx_status migraphx_compile_options_set_exhaustive_tune_flag(
     migraphx_compile_options_t compile_options, bool value);
 
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_compile_options_set_cache_dir(migraphx_compile_options_t compile_options, const char* dir);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_compile_options_set_cache_max_size(
+    migraphx_compile_options_t compile_options, size_t value);
+
 MIGRAPHX_C_EXPORT migraphx_status migraphx_parse_onnx(migraphx_program_t* out,
                                                       const char* name,
                                                       migraphx_onnx_options_t options);
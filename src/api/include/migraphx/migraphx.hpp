@@ -1134,6 +1134,20 @@ struct compile_options : MIGRAPHX_HANDLE_BASE(compile_options)
     {
         call(&migraphx_compile_options_set_exhaustive_tune_flag, this->get_handle_ptr(), value);
     }
+
+    /// Load the compiled program from this directory when it was compiled before with the same
+    /// model, target and options, otherwise save it there after compiling.
+    void set_cache_dir(const char* dir)
+    {
+        call(&migraphx_compile_options_set_cache_dir, this->get_handle_ptr(), dir);
+    }
+
+    /// Evict the least recently used programs once the cache directory grows past this many
+    /// bytes, 0 means there is no limit
+    void set_cache_max_size(size_t value)
+    {
+        call(&migraphx_compile_options_set_cache_max_size, this->get_handle_ptr(), value);
+    }
 };
 
 /// A program represents the all computation graphs to be compiled and executed
@@ -376,6 +376,12 @@ def compile_options(h):
     h.method('set_exhaustive_tune_flag',
              api.params(value='bool'),
              invoke='migraphx::set_exhaustive_tune_flag($@)')
+    h.method('set_cache_dir',
+             api.params(dir='const char*'),
+             invoke='migraphx::set_cache_dir($@)')
+    h.method('set_cache_max_size',
+             api.params(value='size_t'),
+             invoke='migraphx::set_cache_max_size($@)')
 
 
 api.add_function('migraphx_parse_onnx',
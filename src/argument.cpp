@@ -23,6 +23,7 @@
  */
 #include <migraphx/argument.hpp>
 #include <migraphx/functional.hpp>
+#include <migraphx/host_buffer_pool.hpp>
 #include <unordered_map>
 
 namespace migraphx {
@@ -30,23 +31,21 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 argument::argument(const shape& s) : m_shape(s)
 {
-    auto buffer = make_shared_array<char>(s.bytes());
-    assign_buffer({[=]() mutable { return buffer.get(); }});
+    auto buffer = allocate_host_buffer(s.bytes());
+    auto* p     = buffer.get();
+    assign_buffer(p, std::move(buffer));
 }
 
-argument::argument(shape s, std::nullptr_t)
-    : m_shape(std::move(s)), m_data({[] { return nullptr; }})
-{
-}
+argument::argument(shape s, std::nullptr_t) : m_shape(std::move(s)) { m_data.assigned = true; }
 
 argument::argument(const shape& s, const argument::data_t& d) : m_shape(s), m_data(d) {}
 
-void argument::assign_buffer(std::function<char*()> d)
+void argument::assign_buffer(char* p, std::shared_ptr<void> owner)
 {
     const shape& s = m_shape;
     if(s.type() != shape::tuple_type)
     {
-        m_data = {std::move(d)};
+        m_data = {p, std::move(owner), true};
         return;
     }
     // Collect all shapes
@@ -82,22 +81,20 @@ void argument::assign_buffer(std::function<char*()> d)
     }
     assert(offset == s.bytes());
 
+    // Every element shares the owner of the whole buffer
     std::size_t i = 0;
     m_data        = fix<data_t>([&](auto self, auto ss) {
         data_t result;
         if(ss.sub_shapes().empty())
         {
-            auto n = offsets[i];
-            result = {[d, n]() mutable { return d() + n; }};
+            result = {p == nullptr ? nullptr : p + offsets[i], owner, true};
             i++;
             return result;
         }
-        std::vector<data_t> subs;
         std::transform(ss.sub_shapes().begin(),
                        ss.sub_shapes().end(),
-                       std::back_inserter(subs),
+                       std::back_inserter(result.sub),
                        [&](auto child) { return self(child); });
-        result.sub = subs;
         return result;
     })(s);
 }
@@ -120,10 +117,10 @@ char* argument::data() const
 {
     assert(m_shape.type() != shape::tuple_type);
     assert(not this->empty());
-    return m_data.get();
+    return m_data.ptr;
 }
 
-bool argument::empty() const { return not m_data.get and m_data.sub.empty(); }
+bool argument::empty() const { return not m_data.assigned and m_data.sub.empty(); }
 
 const shape& argument::get_shape() const { return this->m_shape; }
 
@@ -133,20 +130,6 @@ argument argument::reshape(const shape& s) const
     return {s, this->m_data};
 }
 
-argument::data_t argument::data_t::share() const
-{
-    data_t result;
-    if(this->get)
-    {
-        auto self  = std::make_shared<data_t>(*this);
-        result.get = [self]() mutable { return self->get(); };
-    }
-    std::transform(sub.begin(), sub.end(), std::back_inserter(result.sub), [](const auto& d) {
-        return d.share();
-    });
-    return result;
-}
-
 argument::data_t argument::data_t::from_args(const std::vector<argument>& args)
 {
     data_t result;
@@ -164,7 +147,7 @@ argument argument::copy() const
     return result;
 }
 
-argument argument::share() const { return {m_shape, m_data.share()}; }
+argument argument::share() const { return *this; }
 
 std::vector<argument> argument::get_sub_objects() const
 {
@@ -180,12 +163,27 @@ std::vector<argument> argument::get_sub_objects() const
     return result;
 }
 
+// Scalar shapes are shared so that taking an element doesn't allocate a new shape
+static const shape& scalar_shape(shape::type_t t)
+{
+    static const std::vector<shape> shapes = [] {
+        std::vector<shape> result(shape::types().size());
+        for(auto type : shape::types())
+        {
+            if(type != shape::tuple_type)
+                result[type] = shape{type};
+        }
+        return result;
+    }();
+    return shapes.at(t);
+}
+
 argument argument::element(std::size_t i) const
 {
     assert(this->get_shape().sub_shapes().empty());
     auto idx    = this->get_shape().index(i);
     auto offset = this->get_shape().type_size() * idx;
-    return argument{shape{this->get_shape().type()}, this->data() + offset};
+    return argument{scalar_shape(this->get_shape().type()), this->data() + offset};
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,224 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/compile_cache.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/hash.hpp>
+#include <migraphx/load_save.hpp>
+#include <migraphx/msgpack.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/version.h>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+namespace {
+
+// A hash that is stable across processes and platforms, unlike std::hash
+std::uint64_t fnv1a(const std::vector<char>& buffer, std::uint64_t h = 14695981039346656037ull)
+{
+    for(char c : buffer)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::string to_hex(std::uint64_t x)
+{
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << x;
+    return ss.str();
+}
+
+std::string unique_suffix()
+{
+    std::random_device rd;
+    std::uint64_t r = (std::uint64_t{rd()} << 32u) ^ rd();
+    return to_hex(r ^ std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+
+struct cache_entry
+{
+    fs::path path;
+    fs::file_time_type time;
+    std::size_t size = 0;
+};
+
+std::vector<cache_entry> list_entries(const fs::path& dir)
+{
+    std::vector<cache_entry> entries;
+    std::error_code ec;
+    for(const auto& e : fs::directory_iterator(dir, ec))
+    {
+        if(e.path().extension() != ".mxr")
+            continue;
+        std::error_code eec;
+        cache_entry entry;
+        entry.path = e.path();
+        entry.time = fs::last_write_time(e.path(), eec);
+        entry.size = fs::file_size(e.path(), eec);
+        // The entry was removed by another process
+        if(eec)
+            continue;
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+} // namespace
+
+compile_cache::compile_cache(fs::path d, std::size_t max) : dir(std::move(d)), max_bytes(max) {}
+
+std::string compile_cache::key(const program& p, const target& t, const compile_options& options)
+{
+    value v     = {{"version",
+                    std::to_string(MIGRAPHX_VERSION_MAJOR) + "." +
+                        std::to_string(MIGRAPHX_VERSION_MINOR) + "." +
+                        std::to_string(MIGRAPHX_VERSION_PATCH) + "." + MIGRAPHX_VERSION_TWEAK},
+                   {"target", t.name()},
+                   {"context", t.get_context().to_value()},
+                   {"offload_copy", options.offload_copy},
+                   {"fast_math", options.fast_math},
+                   {"exhaustive_tune", options.exhaustive_tune}};
+    auto header = fnv1a(to_msgpack(v));
+    auto model  = save_buffer(p);
+    // Use two independent hashes of the model to make collisions between models unlikely
+    std::size_t h = hash_value(std::string_view{model.data(), model.size()});
+    hash_combine(h, header);
+    return to_hex(fnv1a(model, header)) + to_hex(h);
+}
+
+fs::path compile_cache::path(const std::string& k) const { return dir / (k + ".mxr"); }
+
+bool compile_cache::contains(const std::string& k) const
+{
+    std::error_code ec;
+    return fs::exists(path(k), ec);
+}
+
+optional<program> compile_cache::load(const std::string& k) const
+{
+    if(not contains(k))
+        return nullopt;
+    auto file = path(k);
+    std::vector<char> buffer;
+    try
+    {
+        buffer = read_buffer(file.string());
+    }
+    catch(const std::exception&)
+    {
+        // The entry was evicted by another process
+        return nullopt;
+    }
+    std::error_code ec;
+    try
+    {
+        auto p = load_buffer(buffer);
+        // Mark the entry as recently used
+        fs::last_write_time(file, fs::file_time_type::clock::now(), ec);
+        return p;
+    }
+    catch(const std::exception&)
+    {
+        // The entry is corrupt or from an incompatible version so it will be recompiled
+        fs::remove(file, ec);
+        return nullopt;
+    }
+}
+
+void compile_cache::store(const std::string& k, const program& p) const
+{
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if(ec)
+        MIGRAPHX_THROW("Unable to create compile cache directory " + dir.string() + ": " +
+                       ec.message());
+    auto buffer = save_buffer(p);
+    // Write to a temporary file first so other processes never see a partial entry
+    auto tmp = dir / (k + "." + unique_suffix() + ".tmp");
+    {
+        std::ofstream os(tmp, std::ios::binary);
+        os.write(buffer.data(), buffer.size());
+        if(not os)
+        {
+            fs::remove(tmp, ec);
+            MIGRAPHX_THROW("Unable to write compile cache entry " + tmp.string());
+        }
+    }
+    fs::rename(tmp, path(k), ec);
+    if(ec)
+    {
+        fs::remove(tmp, ec);
+        MIGRAPHX_THROW("Unable to write compile cache entry " + path(k).string());
+    }
+    evict();
+}
+
+std::size_t compile_cache::size() const
+{
+    auto entries = list_entries(dir);
+    return std::accumulate(
+        entries.begin(), entries.end(), std::size_t{0}, [](std::size_t x, const auto& e) {
+            return x + e.size;
+        });
+}
+
+void compile_cache::evict() const
+{
+    if(max_bytes == 0)
+        return;
+    auto entries = list_entries(dir);
+    std::size_t total =
+        std::accumulate(entries.begin(), entries.end(), std::size_t{0}, [](auto x, const auto& e) {
+            return x + e.size;
+        });
+    if(total <= max_bytes)
+        return;
+    std::sort(entries.begin(), entries.end(), [](const auto& x, const auto& y) {
+        return x.time < y.time;
+    });
+    for(const auto& e : entries)
+    {
+        if(total <= max_bytes)
+            break;
+        std::error_code ec;
+        fs::remove(e.path, ec);
+        total -= e.size;
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,271 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/copy_layout.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/reduce_dims.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/simple_par_for.hpp>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+namespace {
+
+// Number of elements along each side of a transpose tile
+constexpr std::size_t tile_size = 32;
+// Copies smaller than this are not split across threads
+constexpr std::size_t min_bytes_per_thread = std::size_t{1} << 18;
+
+struct copy_dims
+{
+    std::vector<std::size_t> lens        = {};
+    std::vector<std::size_t> dst_strides = {};
+    std::vector<std::size_t> src_strides = {};
+
+    std::size_t elements() const
+    {
+        return std::accumulate(lens.begin(), lens.end(), std::size_t{1}, std::multiplies<>{});
+    }
+
+    shape_odometer odometer(std::size_t i) const
+    {
+        return shape_odometer{lens, {dst_strides, src_strides}, i};
+    }
+
+    copy_dims remove(const std::vector<std::size_t>& axes) const
+    {
+        copy_dims result;
+        for(std::size_t i = 0; i < lens.size(); i++)
+        {
+            if(std::find(axes.begin(), axes.end(), i) != axes.end())
+                continue;
+            result.lens.push_back(lens[i]);
+            result.dst_strides.push_back(dst_strides[i]);
+            result.src_strides.push_back(src_strides[i]);
+        }
+        return result;
+    }
+};
+
+// Drop unit dimensions, order the rest by the destination layout and merge the dimensions that
+// are contiguous in both tensors
+copy_dims normalize_dims(const shape& src_shape, const shape& dst_shape)
+{
+    const auto& lens = dst_shape.lens();
+    std::vector<std::size_t> axes;
+    for(std::size_t i = 0; i < lens.size(); i++)
+    {
+        if(lens[i] != 1)
+            axes.push_back(i);
+    }
+    copy_dims result;
+    if(axes.empty())
+        return result;
+    std::stable_sort(axes.begin(), axes.end(), [&](auto x, auto y) {
+        return std::make_pair(dst_shape.strides()[x], src_shape.strides()[x]) >
+               std::make_pair(dst_shape.strides()[y], src_shape.strides()[y]);
+    });
+    for(auto axis : axes)
+    {
+        result.lens.push_back(lens[axis]);
+        result.dst_strides.push_back(dst_shape.strides()[axis]);
+        result.src_strides.push_back(src_shape.strides()[axis]);
+    }
+    auto reduced = reduce_dims({shape{dst_shape.type(), result.lens, result.dst_strides},
+                                shape{dst_shape.type(), result.lens, result.src_strides}});
+    result.lens        = reduced[0].lens();
+    result.dst_strides = reduced[0].strides();
+    result.src_strides = reduced[1].strides();
+    return result;
+}
+
+// Split [0, n) into one range per thread, using fewer threads for small copies
+template <class F>
+void par_ranges(std::size_t n, std::size_t bytes, F f)
+{
+    std::size_t nthreads = std::min<std::size_t>(
+        {std::max<std::size_t>(1, std::thread::hardware_concurrency()),
+         n,
+         std::max<std::size_t>(1, bytes / min_bytes_per_thread)});
+    if(nthreads <= 1)
+    {
+        f(std::size_t{0}, n);
+        return;
+    }
+    std::size_t grain = (n + nthreads - 1) / nthreads;
+    simple_par_for(nthreads, 1, [&](std::size_t t) {
+        auto start = t * grain;
+        auto last  = std::min(n, start + grain);
+        if(start < last)
+            f(start, last);
+    });
+}
+
+template <std::size_t N>
+void copy_element(char* dst, const char* src)
+{
+    std::memcpy(dst, src, N);
+}
+
+// Both tensors are contiguous along the innermost dimension
+void copy_rows(const copy_dims& d, const char* src, char* dst, std::size_t n)
+{
+    auto last      = d.lens.size() - 1;
+    auto row_bytes = d.lens[last] * n;
+    auto outer     = d.remove({last});
+    auto rows      = outer.elements();
+    if(rows == 1)
+    {
+        par_ranges(row_bytes, row_bytes, [&](auto start, auto stop) {
+            std::memcpy(dst + start, src + start, stop - start);
+        });
+        return;
+    }
+    par_ranges(rows, rows * row_bytes, [&](auto start, auto stop) {
+        auto it = outer.odometer(start);
+        for(auto i = start; i < stop; i++, ++it)
+            std::memcpy(dst + it.offset(0) * n, src + it.offset(1) * n, row_bytes);
+    });
+}
+
+// The destination is contiguous along the innermost dimension and the source is contiguous
+// along dimension k, so copy 2D tiles that fit in cache on both sides
+template <std::size_t N>
+void copy_tiles(const copy_dims& d, std::size_t k, const char* src, char* dst)
+{
+    auto last      = d.lens.size() - 1;
+    auto rows      = d.lens[k];
+    auto cols      = d.lens[last];
+    auto dst_row   = d.dst_strides[k];
+    auto src_col   = d.src_strides[last];
+    auto outer     = d.remove({k, last});
+    auto row_tiles = (rows + tile_size - 1) / tile_size;
+    auto units     = outer.elements() * row_tiles;
+    par_ranges(units, d.elements() * N, [&](auto start, auto stop) {
+        auto it = outer.odometer(start / row_tiles);
+        for(auto u = start; u < stop; u++)
+        {
+            auto rt = u % row_tiles;
+            if(u != start and rt == 0)
+                ++it;
+            auto* out      = dst + it.offset(0) * N;
+            const auto* in = src + it.offset(1) * N;
+            auto i0        = rt * tile_size;
+            auto i1        = std::min(rows, i0 + tile_size);
+            for(std::size_t j0 = 0; j0 < cols; j0 += tile_size)
+            {
+                auto j1 = std::min(cols, j0 + tile_size);
+                for(auto i = i0; i < i1; i++)
+                {
+                    for(auto j = j0; j < j1; j++)
+                        copy_element<N>(out + (i * dst_row + j) * N, in + (i + j * src_col) * N);
+                }
+            }
+        }
+    });
+}
+
+// Any other layout, including broadcasted sources, is copied one strided row at a time
+template <std::size_t N>
+void copy_strided(const copy_dims& d, const char* src, char* dst)
+{
+    auto last       = d.lens.size() - 1;
+    auto len        = d.lens[last];
+    auto dst_stride = d.dst_strides[last];
+    auto src_stride = d.src_strides[last];
+    auto outer      = d.remove({last});
+    auto rows       = outer.elements();
+    par_ranges(rows, d.elements() * N, [&](auto start, auto stop) {
+        auto it = outer.odometer(start);
+        for(auto i = start; i < stop; i++, ++it)
+        {
+            auto* out      = dst + it.offset(0) * N;
+            const auto* in = src + it.offset(1) * N;
+            for(std::size_t j = 0; j < len; j++)
+                copy_element<N>(out + j * dst_stride * N, in + j * src_stride * N);
+        }
+    });
+}
+
+template <class F>
+void visit_element_size(std::size_t n, F f)
+{
+    switch(n)
+    {
+    case 1: f(std::integral_constant<std::size_t, 1>{}); break;
+    case 2: f(std::integral_constant<std::size_t, 2>{}); break;
+    case 4: f(std::integral_constant<std::size_t, 4>{}); break;
+    case 8: f(std::integral_constant<std::size_t, 8>{}); break;
+    default: MIGRAPHX_THROW("COPY_LAYOUT: Unsupported element size " + std::to_string(n));
+    }
+}
+
+} // namespace
+
+void copy_layout(const shape& src_shape, const char* src, const shape& dst_shape, char* dst)
+{
+    if(src_shape.lens() != dst_shape.lens())
+        MIGRAPHX_THROW("COPY_LAYOUT: Source and destination lens must match");
+    if(src_shape.type_size() != dst_shape.type_size())
+        MIGRAPHX_THROW("COPY_LAYOUT: Source and destination element sizes must match");
+    if(dst_shape.elements() == 0)
+        return;
+    auto n = dst_shape.type_size();
+    auto d = normalize_dims(src_shape, dst_shape);
+    if(d.lens.empty())
+    {
+        std::memcpy(dst, src, n);
+        return;
+    }
+    auto last = d.lens.size() - 1;
+    if(d.dst_strides[last] == 1 and d.src_strides[last] == 1)
+    {
+        copy_rows(d, src, dst, n);
+        return;
+    }
+    std::size_t k =
+        std::find(d.src_strides.begin(), d.src_strides.begin() + last, 1) - d.src_strides.begin();
+    visit_element_size(n, [&](auto size) {
+        constexpr std::size_t m = decltype(size){};
+        if(d.dst_strides[last] == 1 and d.src_strides[last] != 0 and k < last)
+            copy_tiles<m>(d, k, src, dst);
+        else
+            copy_strided<m>(d, src, dst);
+    });
+}
+
+void copy_layout(const argument& src, const argument& dst)
+{
+    copy_layout(src.get_shape(), src.data(), dst.get_shape(), dst.data());
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
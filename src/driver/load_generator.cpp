@@ -0,0 +1,252 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "load_generator.hpp"
+
+#include <migraphx/errors.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <ctime>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+using load_clock = std::chrono::steady_clock;
+
+static double to_ms(load_clock::duration d)
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+// CPU time used by the calling thread in seconds
+static double thread_cpu_seconds()
+{
+#ifdef _WIN32
+    return 0;
+#else
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static double process_cpu_seconds() { return static_cast<double>(std::clock()) / CLOCKS_PER_SEC; }
+
+// Blocks every worker after its warmup until all of them are ready, then releases them with a
+// common start time
+struct start_gate
+{
+    std::mutex m;
+    std::condition_variable cv;
+    std::size_t waiting = 0;
+    std::size_t total   = 0;
+    bool started        = false;
+    load_clock::time_point start{};
+
+    load_clock::time_point wait()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        waiting++;
+        if(waiting == total)
+        {
+            start   = load_clock::now();
+            started = true;
+            cv.notify_all();
+        }
+        cv.wait(lock, [&] { return started; });
+        return start;
+    }
+};
+
+load_report run_load(std::vector<load_worker> workers, const load_options& options)
+{
+    if(workers.empty())
+        MIGRAPHX_THROW("No workers to generate load with");
+    auto n            = workers.size();
+    bool timed_run    = options.duration > 0;
+    std::size_t total = timed_run ? std::numeric_limits<std::size_t>::max() : options.iterations;
+    auto duration = std::chrono::duration_cast<load_clock::duration>(
+        std::chrono::duration<double>(options.duration));
+    auto interval = std::chrono::duration_cast<load_clock::duration>(
+        std::chrono::duration<double>(options.rate > 0 ? 1.0 / options.rate : 0));
+
+    start_gate gate;
+    gate.total = n;
+    std::atomic<std::size_t> next{0};
+    std::vector<std::vector<double>> latencies(n);
+    std::vector<double> cpu_seconds(n);
+    std::vector<std::exception_ptr> errors(n);
+
+    auto run_worker = [&](std::size_t w) {
+        auto& worker = workers[w];
+        auto eval    = [&] {
+            worker.p.eval(worker.params);
+            worker.p.finish();
+        };
+        try
+        {
+            for(std::size_t i = 0; i < options.warmup; i++)
+                eval();
+        }
+        catch(...)
+        {
+            errors[w] = std::current_exception();
+        }
+        auto begin = gate.wait();
+        if(errors[w] != nullptr)
+            return;
+        auto cpu_start = thread_cpu_seconds();
+        try
+        {
+            for(std::size_t i = next++; i < total; i = next++)
+            {
+                // Open loop: the request arrives at its scheduled time even if every worker is
+                // busy, so queueing delay is part of the latency
+                auto issued = options.rate > 0 ? begin + interval * static_cast<load_clock::rep>(i)
+                                               : load_clock::now();
+                if(timed_run and issued - begin >= duration)
+                    break;
+                std::this_thread::sleep_until(issued);
+                eval();
+                latencies[w].push_back(to_ms(load_clock::now() - issued));
+            }
+        }
+        catch(...)
+        {
+            errors[w] = std::current_exception();
+        }
+        cpu_seconds[w] = thread_cpu_seconds() - cpu_start;
+    };
+
+    auto process_start = process_cpu_seconds();
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(n);
+        for(std::size_t w = 0; w < n; w++)
+            threads.emplace_back(run_worker, w);
+        for(auto& t : threads)
+            t.join();
+    }
+    auto end = load_clock::now();
+    for(const auto& e : errors)
+    {
+        if(e != nullptr)
+            std::rethrow_exception(e);
+    }
+
+    load_report result;
+    result.workers    = n;
+    result.options    = options;
+    result.elapsed_ms = to_ms(end - gate.start);
+    for(const auto& l : latencies)
+        result.latencies.insert(result.latencies.end(), l.begin(), l.end());
+    std::sort(result.latencies.begin(), result.latencies.end());
+    double elapsed_seconds = result.elapsed_ms / 1000.0;
+    std::transform(cpu_seconds.begin(),
+                   cpu_seconds.end(),
+                   std::back_inserter(result.worker_cpu_utilization),
+                   [&](double s) { return elapsed_seconds > 0 ? s / elapsed_seconds : 0.0; });
+    // This includes the warmup, so it is only an approximation for short runs
+    if(elapsed_seconds > 0)
+        result.process_cpu_utilization =
+            (process_cpu_seconds() - process_start) / elapsed_seconds;
+    return result;
+}
+
+double load_report::throughput() const
+{
+    if(elapsed_ms <= 0)
+        return 0;
+    return latencies.size() * 1000.0 / elapsed_ms;
+}
+
+double load_report::percentile(double p) const
+{
+    if(latencies.empty())
+        return 0;
+    // Nearest-rank percentile
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * latencies.size()));
+    return latencies[std::min(latencies.size(), std::max<std::size_t>(rank, 1)) - 1];
+}
+
+value load_report::to_value() const
+{
+    double mean = latencies.empty() ? 0.0
+                                    : std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+                                          latencies.size();
+    value latency = {{"mean", mean},
+                     {"min", latencies.empty() ? 0.0 : latencies.front()},
+                     {"max", latencies.empty() ? 0.0 : latencies.back()},
+                     {"p50", percentile(50)},
+                     {"p90", percentile(90)},
+                     {"p99", percentile(99)},
+                     {"p99.9", percentile(99.9)}};
+    value result;
+    result["workers"]                 = workers;
+    result["batch"]                   = batch;
+    result["warmup"]                  = options.warmup;
+    result["rate"]                    = options.rate;
+    result["duration"]                = options.duration;
+    result["requests"]                = latencies.size();
+    result["elapsed_ms"]              = elapsed_ms;
+    result["requests_per_second"]     = throughput();
+    result["samples_per_second"]      = throughput() * batch;
+    result["latency_ms"]              = latency;
+    result["worker_cpu_utilization"]  = worker_cpu_utilization;
+    result["process_cpu_utilization"] = process_cpu_utilization;
+    return result;
+}
+
+void load_report::print(std::ostream& os) const
+{
+    os << "Workers: " << workers;
+    if(options.rate > 0)
+        os << ", open loop at " << options.rate << " requests/s";
+    else
+        os << ", closed loop";
+    os << std::endl;
+    os << "Requests: " << latencies.size() << " in " << elapsed_ms << "ms" << std::endl;
+    os << "Throughput: " << throughput() << " requests/s, " << throughput() * batch
+       << " samples/s" << std::endl;
+    os << "Latency: p50 " << percentile(50) << "ms, p90 " << percentile(90) << "ms, p99 "
+       << percentile(99) << "ms, p99.9 " << percentile(99.9) << "ms" << std::endl;
+    os << "Worker CPU utilization:";
+    for(auto u : worker_cpu_utilization)
+        os << " " << std::round(u * 100) << "%";
+    os << std::endl;
+    os << "Process CPU utilization: " << process_cpu_utilization << " CPUs" << std::endl;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_DRIVER_LOAD_GENERATOR_HPP
+#define MIGRAPHX_GUARD_DRIVER_LOAD_GENERATOR_HPP
+
+#include <migraphx/program.hpp>
+#include <migraphx/value.hpp>
+#include <iosfwd>
+#include <vector>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct load_options
+{
+    /// Number of timed requests across all workers, ignored when a duration is set
+    std::size_t iterations = 100;
+    /// Number of untimed requests each worker runs before the timed phase starts
+    std::size_t warmup = 10;
+    /// Requests per second for an open-loop arrival schedule, or 0 to issue the next request
+    /// as soon as a worker is free
+    double rate = 0;
+    /// Seconds to run the timed phase for, or 0 to run a fixed number of iterations
+    double duration = 0;
+};
+
+/// A compiled program and its parameters, evaluated by one worker thread
+struct load_worker
+{
+    program p;
+    parameter_map params;
+};
+
+struct load_report
+{
+    std::size_t workers = 0;
+    std::size_t batch   = 1;
+    load_options options{};
+    /// Latencies of every timed request in milliseconds, sorted
+    std::vector<double> latencies{};
+    double elapsed_ms = 0;
+    /// Fraction of the timed phase each worker thread spent on a CPU
+    std::vector<double> worker_cpu_utilization{};
+    /// Average number of CPUs the whole process used during the timed phase
+    double process_cpu_utilization = 0;
+
+    double throughput() const;
+    double percentile(double p) const;
+
+    value to_value() const;
+    void print(std::ostream& os) const;
+};
+
+/**
+ * Evaluate the programs concurrently, one thread per worker, and collect the latency of each
+ * request. Every worker needs its own program and parameters so no state is shared between
+ * threads. With a rate, requests are scheduled at fixed arrival times and the latency includes
+ * the time spent waiting for a free worker.
+ */
+load_report run_load(std::vector<load_worker> workers, const load_options& options);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
+
+#endif
@@ -28,6 +28,7 @@
 #include "precision.hpp"
 #include "passes.hpp"
 #include "perf.hpp"
+#include "load_generator.hpp"
 #include "models.hpp"
 #include "marker_roctx.hpp"
 
@@ -47,6 +48,7 @@
 #include <migraphx/eliminate_pad.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <migraphx/pass_stats.hpp>
 #include <migraphx/propagate_constant.hpp>
 #include <migraphx/quantization.hpp>
 #include <migraphx/register_op.hpp>
@@ -467,6 +469,14 @@ struct compiler
            {"--exhaustive-tune"},
            ap.help("Exhastively search for best tuning parameters for kernels"),
            ap.set_value(true));
+        ap(co.cache_dir,
+           {"--compile-cache"},
+           ap.help("Load the compiled program from this directory if it was compiled before with "
+                   "the same target and options, otherwise save it there"));
+        ap(co.cache_max_bytes,
+           {"--compile-cache-max-size"},
+           ap.help("Evict the least recently used programs from the compile cache once it grows "
+                   "past this many bytes"));
         ap(to_fp16, {"--fp16"}, ap.help("Quantize for fp16"), ap.set_value(true));
         ap(to_int8, {"--int8"}, ap.help("Quantize for int8"), ap.set_value(true));
         ap(to_fp8, {"--fp8"}, ap.help("Quantize for fp8e4m3fnuz type"), ap.set_value(true));
@@ -618,12 +628,30 @@ struct verify : command<verify>
 struct compile : command<compile>
 {
     compiler c;
-    void parse(argument_parser& ap) { c.parse(ap); }
+    std::string pass_stats_file;
+    void parse(argument_parser& ap)
+    {
+        c.parse(ap);
+        ap(pass_stats_file,
+           {"--pass-stats"},
+           ap.help("Write the time and graph size of every compile pass as JSON to this file"));
+    }
 
     void run()
     {
+        pass_stats stats;
+        if(not pass_stats_file.empty())
+            c.co.stats = &stats;
         std::cout << "Compiling ... " << std::endl;
         c.compile();
+        if(pass_stats_file.empty())
+            return;
+        stats.print(std::cout);
+        auto result       = stats.to_value();
+        result["model"]   = c.l.file.empty() ? c.l.model : c.l.file;
+        result["target"]  = c.ct.target_name;
+        result["version"] = get_version();
+        std::ofstream(pass_stats_file) << to_json_string(result) << std::endl;
     }
 };
 
@@ -647,21 +675,71 @@ struct perf : command<perf>
 {
     compiler c;
     unsigned n = 100;
+    load_options lo;
+    unsigned workers = 0;
+    std::string json_file;
     void parse(argument_parser& ap)
     {
         c.parse(ap);
         ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to run for perf report"));
+        ap(workers,
+           {"--workers"},
+           ap.help("Run a load test with this many concurrent workers, each with its own copy of "
+                   "the program, instead of the perf report"));
+        ap(lo.rate,
+           {"--rate"},
+           ap.help("Issue requests at this many per second (open loop) in the load test"));
+        ap(lo.duration,
+           {"--duration"},
+           ap.help("Run the load test for this many seconds instead of a number of iterations"));
+        ap(lo.warmup, {"--warmup"}, ap.help("Number of untimed warmup runs for each worker"));
+        ap(json_file, {"--json"}, ap.help("Write the load test results as JSON to this file"));
+    }
+
+    bool load_test() const
+    {
+        return workers > 0 or lo.rate > 0 or lo.duration > 0 or not json_file.empty();
     }
 
     void run()
     {
         std::cout << "Compiling ... " << std::endl;
         auto p = c.compile();
+        if(load_test())
+        {
+            run_load_test(p);
+            return;
+        }
         std::cout << "Allocating params ... " << std::endl;
         auto m = c.params(p);
         std::cout << "Running performance report ... " << std::endl;
         p.perf_report(std::cout, n, m, c.l.batch);
     }
+
+    void run_load_test(const program& p)
+    {
+        std::cout << "Allocating params ... " << std::endl;
+        std::vector<load_worker> lws;
+        for(unsigned i = 0; i < std::max(1u, workers); i++)
+        {
+            load_worker lw{p, {}};
+            lw.params = c.params(lw.p);
+            lws.push_back(std::move(lw));
+        }
+        lo.iterations = n;
+        std::cout << "Running load test ... " << std::endl;
+        auto report  = run_load(std::move(lws), lo);
+        report.batch = c.l.batch;
+        report.print(std::cout);
+        if(not json_file.empty())
+        {
+            auto result       = report.to_value();
+            result["model"]   = c.l.file.empty() ? c.l.model : c.l.file;
+            result["target"]  = c.ct.target_name;
+            result["version"] = get_version();
+            std::ofstream(json_file) << to_json_string(result) << std::endl;
+        }
+    }
 };
 
 struct roctx : command<roctx>
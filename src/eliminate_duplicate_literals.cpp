@@ -0,0 +1,76 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/eliminate_duplicate_literals.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+void eliminate_duplicate_literals::apply(program& p) const
+{
+    std::unordered_multimap<std::size_t, instruction_ref> literals;
+    for(auto* mod : p.get_modules())
+    {
+        std::vector<instruction_ref> mod_literals;
+        for(auto ins : iterator_for(*mod))
+        {
+            // The last instruction is the output of the module when there is no return
+            if(ins->name() == "@literal" and ins != std::prev(mod->end()))
+                mod_literals.push_back(ins);
+        }
+        for(auto ins : mod_literals)
+        {
+            auto h     = ins->get_literal().hash();
+            auto found = range(literals.equal_range(h));
+            auto same  = [&](const auto& pp) { return *pp.second == *ins; };
+            // Prefer a literal in the same module since it can be used directly
+            auto it = std::find_if(found.begin(), found.end(), [&](const auto& pp) {
+                return mod->has_instruction(pp.second) and same(pp);
+            });
+            if(it != found.end())
+            {
+                mod->replace_instruction(ins, it->second);
+                mod->remove_instruction(ins);
+                continue;
+            }
+            it = std::find_if(found.begin(), found.end(), same);
+            if(it == found.end() or it->second->get_literal().shares_buffer(ins->get_literal()))
+            {
+                literals.emplace(h, ins);
+                continue;
+            }
+            auto shared = mod->insert_literal(ins, it->second->get_literal());
+            mod->replace_instruction(ins, shared);
+            mod->remove_instruction(ins);
+            literals.emplace(h, shared);
+        }
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
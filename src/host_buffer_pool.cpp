@@ -0,0 +1,246 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/host_buffer_pool.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/errors.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_HOST_BUFFER_ALIGNMENT)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_HOST_BUFFER_POOL_LIMIT)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_HOST_BUFFER_HUGE_PAGES)
+
+static constexpr std::size_t huge_page_size = std::size_t{2} << 20u;
+
+static bool is_power_of_two(std::size_t n) { return n != 0 and (n & (n - 1)) == 0; }
+
+static std::size_t round_up(std::size_t n, std::size_t m) { return (n + m - 1) / m * m; }
+
+static char* system_allocate(std::size_t n, std::size_t alignment, bool huge_pages)
+{
+#ifdef _WIN32
+    auto* p = static_cast<char*>(_aligned_malloc(n, alignment));
+#else
+    auto* p = static_cast<char*>(std::aligned_alloc(alignment, n));
+#endif
+    if(p == nullptr)
+        throw std::bad_alloc{};
+#ifdef MADV_HUGEPAGE
+    // Only a hint, the buffer is still usable when transparent huge pages are unavailable
+    if(huge_pages)
+        madvise(p, n, MADV_HUGEPAGE);
+#else
+    (void)huge_pages;
+#endif
+    return p;
+}
+
+static void system_free(char* p)
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p); // NOLINT
+#endif
+}
+
+struct host_buffer_pool_impl
+{
+    std::size_t alignment        = 64;
+    std::size_t max_cached_bytes = 0;
+    bool huge_pages              = false;
+    std::mutex mutex;
+    std::unordered_map<std::size_t, std::vector<char*>> free_buffers;
+    host_buffer_pool::statistics stats;
+
+    host_buffer_pool_impl(std::size_t a, std::size_t m, bool h)
+        : alignment(std::max<std::size_t>(a, alignof(std::max_align_t))),
+          max_cached_bytes(m),
+          huge_pages(h)
+    {
+        if(not is_power_of_two(a))
+            MIGRAPHX_THROW("host_buffer_pool: alignment must be a power of two: " +
+                           std::to_string(a));
+    }
+
+    host_buffer_pool_impl(const host_buffer_pool_impl&)            = delete;
+    host_buffer_pool_impl& operator=(const host_buffer_pool_impl&) = delete;
+
+    ~host_buffer_pool_impl() { release(); }
+
+    bool use_huge_pages(std::size_t size) const { return huge_pages and size >= huge_page_size; }
+
+    // Round up to one of four classes per power of two, which bounds the wasted space to a
+    // quarter of the request while keeping the number of distinct classes small
+    std::size_t size_class(std::size_t n) const
+    {
+        auto m           = round_up(std::max<std::size_t>(n, 1), alignment);
+        std::size_t half = 1;
+        while(half * 2 < m)
+            half *= 2;
+        auto size = round_up(m, std::max(alignment, half / 4));
+        if(use_huge_pages(size))
+            size = round_up(size, huge_page_size);
+        return size;
+    }
+
+    char* acquire(std::size_t size)
+    {
+        char* p = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.allocations++;
+            stats.bytes_in_use += size;
+            stats.peak_bytes_in_use = std::max(stats.peak_bytes_in_use, stats.bytes_in_use);
+            auto it                 = free_buffers.find(size);
+            if(it != free_buffers.end() and not it->second.empty())
+            {
+                p = it->second.back();
+                it->second.pop_back();
+                stats.reuses++;
+                stats.bytes_cached -= size;
+            }
+        }
+        if(p == nullptr)
+        {
+            auto huge = use_huge_pages(size);
+            p         = system_allocate(size, huge ? huge_page_size : alignment, huge);
+        }
+        return p;
+    }
+
+    void recycle(char* p, std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.bytes_in_use -= size;
+            if(stats.bytes_cached + size <= max_cached_bytes)
+            {
+                free_buffers[size].push_back(p);
+                stats.bytes_cached += size;
+                return;
+            }
+        }
+        system_free(p);
+    }
+
+    void release()
+    {
+        std::unordered_map<std::size_t, std::vector<char*>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers.swap(free_buffers);
+            stats.bytes_cached = 0;
+        }
+        for(auto&& [size, ps] : buffers)
+            std::for_each(ps.begin(), ps.end(), &system_free);
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const host_buffer_pool::statistics& s)
+{
+    os << "allocations: " << s.allocations << ", reuses: " << s.reuses;
+    os << ", bytes in use: " << s.bytes_in_use << ", peak bytes in use: " << s.peak_bytes_in_use;
+    os << ", bytes cached: " << s.bytes_cached;
+    return os;
+}
+
+host_buffer_pool::host_buffer_pool()
+    : host_buffer_pool(value_of(MIGRAPHX_HOST_BUFFER_ALIGNMENT{}, 64),
+                       value_of(MIGRAPHX_HOST_BUFFER_POOL_LIMIT{}, 1024) << 20u)
+{
+}
+
+host_buffer_pool::host_buffer_pool(std::size_t alignment, std::size_t max_cached_bytes)
+    : impl(std::make_shared<host_buffer_pool_impl>(
+          alignment, max_cached_bytes, enabled(MIGRAPHX_HOST_BUFFER_HUGE_PAGES{})))
+{
+}
+
+std::shared_ptr<char> host_buffer_pool::allocate(std::size_t n) const
+{
+    auto size = impl->size_class(n);
+    auto* p   = impl->acquire(size);
+    std::memset(p, 0, n);
+    // The deleter keeps the pool alive until every buffer has been returned
+    return {p, [pool = impl, size](char* q) { pool->recycle(q, size); }};
+}
+
+void host_buffer_pool::release() const { impl->release(); }
+
+host_buffer_pool::statistics host_buffer_pool::get_statistics() const
+{
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->stats;
+}
+
+std::size_t host_buffer_pool::alignment() const { return impl->alignment; }
+
+host_buffer_pool& host_buffer_pool::global()
+{
+    static host_buffer_pool pool;
+    return pool;
+}
+
+static host_buffer_pool*& current_pool()
+{
+    thread_local host_buffer_pool* pool = nullptr;
+    return pool;
+}
+
+host_buffer_pool& current_host_buffer_pool()
+{
+    auto* pool = current_pool();
+    if(pool == nullptr)
+        return host_buffer_pool::global();
+    return *pool;
+}
+
+std::shared_ptr<char> allocate_host_buffer(std::size_t n)
+{
+    return current_host_buffer_pool().allocate(n);
+}
+
+scoped_host_buffer_pool::scoped_host_buffer_pool(host_buffer_pool& pool)
+    : previous(current_pool())
+{
+    current_pool() = &pool;
+}
+
+scoped_host_buffer_pool::~scoped_host_buffer_pool() { current_pool() = previous; }
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
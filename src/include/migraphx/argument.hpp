@@ -29,6 +29,7 @@
 #include <migraphx/config.hpp>
 #include <migraphx/make_shared_array.hpp>
 #include <functional>
+#include <memory>
 #include <utility>
 
 // clang-format off
@@ -53,20 +54,24 @@ struct MIGRAPHX_EXPORT argument : raw_data<argument>
         : m_shape(std::move(s))
 
     {
-        assign_buffer([f = std::move(d)]() mutable { return reinterpret_cast<char*>(f()); });
+        // The function is called once, and kept alive for as long as the buffer is used
+        auto f  = std::make_shared<F>(std::move(d));
+        auto* p = reinterpret_cast<char*>((*f)());
+        assign_buffer(p, std::move(f));
     }
     template <class T>
     argument(shape s, T* d)
         : m_shape(std::move(s))
     {
-        assign_buffer([d] { return reinterpret_cast<char*>(d); });
+        assign_buffer(reinterpret_cast<char*>(d), nullptr);
     }
 
     template <class T>
     argument(shape s, std::shared_ptr<T> d)
         : m_shape(std::move(s))
     {
-        assign_buffer([d] { return reinterpret_cast<char*>(d.get()); });
+        auto* p = reinterpret_cast<char*>(d.get());
+        assign_buffer(p, std::move(d));
     }
 
     argument(shape s, std::nullptr_t);
@@ -104,12 +109,16 @@ struct MIGRAPHX_EXPORT argument : raw_data<argument>
     }
 
     private:
-    void assign_buffer(std::function<char*()> d);
+    void assign_buffer(char* p, std::shared_ptr<void> owner);
     struct data_t
     {
-        std::function<char*()> get = nullptr;
+        // Start of the buffer, or of the element for a tuple element
+        char* ptr = nullptr;
+        // Keeps the buffer alive, this is null when the memory is not owned by the argument
+        std::shared_ptr<void> owner = nullptr;
+        // Set when a buffer was assigned, even if it is a null pointer
+        bool assigned = false;
         std::vector<data_t> sub = {};
-        data_t share() const;
         static data_t from_args(const std::vector<argument>& args);
     };
     argument(const shape& s, const data_t& d);
@@ -0,0 +1,74 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_COMPILE_CACHE_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_COMPILE_CACHE_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/target.hpp>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * A directory of compiled programs saved as MXR files. Entries are keyed by a hash of the
+ * uncompiled program, the target and its context, the compile options and the MIGraphX version.
+ * Entries are written to a temporary file and renamed into place so several processes can share
+ * the same directory, and the least recently used entries are removed once the directory grows
+ * past `max_bytes`.
+ */
+struct MIGRAPHX_EXPORT compile_cache
+{
+    compile_cache(fs::path dir, std::size_t max_bytes = 0);
+
+    /// Compute the key of a program that has not been compiled yet
+    static std::string
+    key(const program& p, const target& t, const compile_options& options = compile_options{});
+
+    /// Load a compiled program, returns nullopt when there is no valid entry for the key
+    optional<program> load(const std::string& k) const;
+    void store(const std::string& k, const program& p) const;
+    bool contains(const std::string& k) const;
+
+    /// Total size in bytes of all entries in the cache
+    std::size_t size() const;
+    /// Remove the least recently used entries until the cache fits in `max_bytes`
+    void evict() const;
+
+    const fs::path& directory() const { return dir; }
+
+    private:
+    fs::path path(const std::string& k) const;
+    fs::path dir;
+    std::size_t max_bytes = 0;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_COMPILE_CACHE_HPP
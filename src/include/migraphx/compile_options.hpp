@@ -26,10 +26,13 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/tracer.hpp>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+struct pass_stats;
+
 struct compile_options
 {
     /**
@@ -41,6 +44,19 @@ struct compile_options
     bool fast_math       = true;
     bool exhaustive_tune = false;
     tracer trace{};
+    /**
+     * When set, the time, instruction counts and peak RSS growth of every pass run during
+     * compilation are aggregated into this object. Export it with pass_stats::to_value.
+     */
+    pass_stats* stats = nullptr;
+    /**
+     * Directory of previously compiled programs. When it has a program compiled from the same
+     * model with the same target and options it is loaded instead of compiling, otherwise the
+     * compiled program is saved there.
+     */
+    std::string cache_dir = "";
+    /// Size in bytes the cache directory can grow to before entries are evicted, 0 for no limit
+    std::size_t cache_max_bytes = 0;
 };
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_DYNAMIC_PAR_FOR_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_DYNAMIC_PAR_FOR_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/simple_par_for.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Call `f(i)` for every `i` in `[0, n)` across a pool of threads where each thread takes the next
+ * index as soon as it is done with the previous one. This balances work of very uneven sizes
+ * better than the static partition of `simple_par_for`. If any call throws, the exception thrown
+ * for the lowest index is rethrown after all threads have finished.
+ */
+template <class F>
+void dynamic_par_for(std::size_t n, F f)
+{
+    const std::size_t nthreads = std::min<std::size_t>(
+        std::max<std::size_t>(1, std::thread::hardware_concurrency()), n);
+    std::vector<std::exception_ptr> errors(n);
+    std::atomic<std::size_t> next{0};
+    simple_par_for(nthreads, 1, [&](std::size_t) {
+        for(auto i = next++; i < n; i = next++)
+        {
+            try
+            {
+                f(i);
+            }
+            catch(...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    });
+    auto it = std::find_if(errors.begin(), errors.end(), [](const auto& e) { return e != nullptr; });
+    if(it != errors.end())
+        std::rethrow_exception(*it);
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_DYNAMIC_PAR_FOR_HPP
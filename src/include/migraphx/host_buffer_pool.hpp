@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_HOST_BUFFER_POOL_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_HOST_BUFFER_POOL_HPP
+
+#include <migraphx/config.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct host_buffer_pool_impl;
+
+/**
+ * Allocates aligned, zero-initialized host buffers and recycles them once they are released.
+ *
+ * Requests are rounded up to a size class (four classes per power of two) and freed buffers are
+ * cached per size class, so repeated evaluations with the same shapes reuse the same memory
+ * instead of going back to the system allocator. The cache is bounded, and buffers stay valid
+ * even if they outlive the pool that allocated them.
+ */
+struct MIGRAPHX_EXPORT host_buffer_pool
+{
+    struct statistics
+    {
+        /// Number of buffers requested from the pool
+        std::size_t allocations = 0;
+        /// Number of requests served from a cached buffer
+        std::size_t reuses = 0;
+        /// Bytes held by buffers that are currently in use
+        std::size_t bytes_in_use = 0;
+        /// Largest value of bytes_in_use seen so far
+        std::size_t peak_bytes_in_use = 0;
+        /// Bytes held by released buffers waiting to be reused
+        std::size_t bytes_cached = 0;
+
+        friend std::ostream& operator<<(std::ostream& os, const statistics& s);
+    };
+
+    /// Uses the alignment and cache limit from the environment
+    host_buffer_pool();
+    /// The alignment must be a power of two, a cache limit of zero disables recycling
+    host_buffer_pool(std::size_t alignment, std::size_t max_cached_bytes);
+
+    /// Allocate a zero-initialized buffer of at least n bytes
+    std::shared_ptr<char> allocate(std::size_t n) const;
+
+    /// Free all cached buffers
+    void release() const;
+
+    statistics get_statistics() const;
+
+    std::size_t alignment() const;
+
+    /// The pool shared by the whole process
+    static host_buffer_pool& global();
+
+    private:
+    std::shared_ptr<host_buffer_pool_impl> impl;
+};
+
+/// The pool used by argument and literal allocations on the calling thread
+MIGRAPHX_EXPORT host_buffer_pool& current_host_buffer_pool();
+
+/// Allocate a zero-initialized buffer from the current pool
+MIGRAPHX_EXPORT std::shared_ptr<char> allocate_host_buffer(std::size_t n);
+
+/// Make a pool the current pool of the calling thread until the end of the scope
+struct MIGRAPHX_EXPORT scoped_host_buffer_pool
+{
+    explicit scoped_host_buffer_pool(host_buffer_pool& pool);
+    scoped_host_buffer_pool(const scoped_host_buffer_pool&)            = delete;
+    scoped_host_buffer_pool& operator=(const scoped_host_buffer_pool&) = delete;
+    ~scoped_host_buffer_pool();
+
+    private:
+    host_buffer_pool* previous;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_HOST_BUFFER_POOL_HPP
@@ -29,10 +29,12 @@
 #include <migraphx/argument.hpp>
 #include <migraphx/tensor_view.hpp>
 #include <migraphx/raw_data.hpp>
-#include <migraphx/make_shared_array.hpp>
+#include <migraphx/host_buffer_pool.hpp>
+#include <migraphx/hash.hpp>
 #include <migraphx/config.hpp>
 
 #include <memory>
+#include <string_view>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -51,7 +53,7 @@ struct literal : raw_data<literal>
     explicit literal(shape::type_t shape_type) : m_shape(shape_type, {}) {}
 
     template <class U, class T = deduce<U>, shape::type_t ShapeType = shape::get_type<T>{}>
-    literal(U x) : buffer(make_shared_array<char>(sizeof(T))), m_shape(ShapeType)
+    literal(U x) : buffer(allocate_host_buffer(sizeof(T))), m_shape(ShapeType)
     {
         static_assert(std::is_trivially_copyable<T>{}, "Literals can only be trivial types");
         *(reinterpret_cast<T*>(buffer.get())) = x;
@@ -59,7 +61,7 @@ struct literal : raw_data<literal>
 
     template <class T>
     literal(const shape& s, const std::vector<T>& x)
-        : buffer(make_shared_array<char>(s.bytes())), m_shape(s)
+        : buffer(allocate_host_buffer(s.bytes())), m_shape(s)
     {
         static_assert(std::is_trivially_copyable<T>{}, "Literals can only be trivial types");
         fill(x.begin(), x.end());
@@ -67,7 +69,7 @@ struct literal : raw_data<literal>
 
     template <class T>
     literal(const shape& s, const std::initializer_list<T>& x)
-        : buffer(make_shared_array<char>(s.bytes())), m_shape(s)
+        : buffer(allocate_host_buffer(s.bytes())), m_shape(s)
     {
         static_assert(std::is_trivially_copyable<T>{}, "Literals can only be trivial types");
         fill(x.begin(), x.end());
@@ -75,14 +77,14 @@ struct literal : raw_data<literal>
 
     template <class Iterator>
     literal(const shape& s, Iterator start, Iterator end)
-        : buffer(make_shared_array<char>(s.bytes())), m_shape(s)
+        : buffer(allocate_host_buffer(s.bytes())), m_shape(s)
     {
         fill(start, end);
     }
 
     // Directly copies buffer of x
     template <class T, MIGRAPHX_REQUIRES(sizeof(T) == 1)>
-    literal(const shape& s, T* x) : buffer(make_shared_array<char>(s.bytes())), m_shape(s)
+    literal(const shape& s, T* x) : buffer(allocate_host_buffer(s.bytes())), m_shape(s)
     {
         std::copy(x, x + s.bytes(), buffer.get());
     }
@@ -97,16 +99,45 @@ struct literal : raw_data<literal>
 
     std::vector<literal> get_sub_objects() const { return {}; }
 
+    /// Hash of the shape and the contents, which is only computed the first time it is used
+    std::size_t hash() const
+    {
+        if(m_hash == 0)
+            m_hash = compute_hash();
+        return m_hash;
+    }
+
+    /// Whether the data is stored in the same buffer as another literal
+    bool shares_buffer(const literal& l) const
+    {
+        return not this->empty() and this->buffer == l.buffer;
+    }
+
     /// Convert the data to an argument
     argument get_argument() const
     {
-        auto b = make_shared_array<char>(buffer.get(), buffer.get() + m_shape.bytes());
-        return {m_shape, [b]() { return b.get(); }};
+        auto b = allocate_host_buffer(m_shape.bytes());
+        std::copy(buffer.get(), buffer.get() + m_shape.bytes(), b.get());
+        return {m_shape, b};
     }
 
     private:
     std::shared_ptr<char> buffer;
     shape m_shape;
+    mutable std::size_t m_hash = 0;
+
+    std::size_t compute_hash() const
+    {
+        std::size_t h = hash_value(m_shape.type());
+        for(auto len : m_shape.lens())
+            hash_combine(h, len);
+        for(auto stride : m_shape.strides())
+            hash_combine(h, stride);
+        if(not this->empty())
+            hash_combine(h, std::string_view{buffer.get(), m_shape.bytes()});
+        // Zero is used to mark the hash as not computed yet
+        return h == 0 ? 1 : h;
+    }
 
     // Keeps the same data ordering as the given container
     template <class Iterator>
@@ -32,8 +32,13 @@
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/type_name.hpp>
 #include <migraphx/source_location.hpp>
+#include <migraphx/rank.hpp>
+#include <migraphx/time.hpp>
 #include <migraphx/config.hpp>
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <iterator>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -95,6 +100,53 @@ struct matcher_context
     module* mod = nullptr;
 };
 
+/// The set of operator names the root instruction of a matcher can have. An
+/// empty optional means the matcher can match an instruction of any name.
+using root_name_set = optional<std::unordered_set<std::string>>;
+
+template <class M>
+auto root_names_impl(rank<1>, const M& m) -> decltype(m.root_names())
+{
+    return m.root_names();
+}
+
+template <class M>
+root_name_set root_names_impl(rank<0>, const M&)
+{
+    return nullopt;
+}
+
+/// Get the operator names the root instruction must have for the matcher to
+/// match. Matchers can provide this by defining a `root_names()` method.
+template <class M>
+root_name_set root_names(const M& m)
+{
+    return root_names_impl(rank<1>{}, m);
+}
+
+/// Root names for when both sets of root names must match
+inline root_name_set intersect_root_names(root_name_set x, const root_name_set& y)
+{
+    if(not x)
+        return y;
+    if(not y)
+        return x;
+    std::unordered_set<std::string> result;
+    std::copy_if(x->begin(), x->end(), std::inserter(result, result.end()), [&](const auto& n) {
+        return y->count(n) > 0;
+    });
+    return result;
+}
+
+/// Root names for when either set of root names can match
+inline root_name_set union_root_names(root_name_set x, const root_name_set& y)
+{
+    if(not x or not y)
+        return nullopt;
+    x->insert(y->begin(), y->end());
+    return x;
+}
+
 /// Convert a predicate function into a matcher
 template <class P>
 struct predicate_matcher
@@ -132,22 +184,33 @@ function_matcher<F> make_function_matcher(F f)
     return {f};
 }
 
+/// Matcher that binds the instruction to name
+template <class M>
+struct bind_matcher
+{
+    M m;
+    std::string name;
+
+    optional<instruction_ref> match(matcher_context& ctx, instruction_ref ins) const
+    {
+        auto result = m.match(ctx, ins);
+        if(result)
+        {
+            if(not ctx.has_instruction(ins))
+                return nullopt;
+            ctx.instructions[name] = ins;
+        }
+        return result;
+    }
+
+    root_name_set root_names() const { return match::root_names(m); }
+};
+
 /// Converts a matcher to bind the instruction to name
 template <class M>
-auto bind_match(M m, std::string name)
+bind_matcher<M> bind_match(M m, std::string name)
 {
-    return make_function_matcher(
-        [=, m_name = std::move(name)](matcher_context& ctx,
-                                      instruction_ref ins) -> optional<instruction_ref> {
-            auto result = m.match(ctx, ins);
-            if(result)
-            {
-                if(not ctx.has_instruction(ins))
-                    return nullopt;
-                ctx.instructions[m_name] = ins;
-            }
-            return result;
-        });
+    return {std::move(m), std::move(name)};
 }
 
 /// Convert a matcher to a bindable matcher
@@ -159,6 +222,8 @@ struct bindable_matcher
     auto bind(std::string name) const { return bind_match(m, std::move(name)); }
 
     auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    root_name_set root_names() const { return match::root_names(m); }
 };
 
 /// Create a bindable matcher
@@ -217,6 +282,39 @@ auto make_basic_fun_matcher(F f);
 template <class P>
 auto make_basic_pred_matcher(P p);
 
+/// Match the instruction with m and then match the result with the packed
+/// matchers. Only m is applied to the root instruction so the root names come
+/// from m.
+template <class M, class Pack>
+struct sub_matcher
+{
+    M m;
+    Pack ms;
+
+    optional<instruction_ref> match(matcher_context& ctx, instruction_ref ins) const
+    {
+        auto result = m.match(ctx, ins);
+        if(result)
+        {
+            bool matches = ms([&](auto... xs) {
+                return fold([&](auto x, auto y) { return x and ctx.matched(y, result); })(true,
+                                                                                         xs...);
+            });
+            if(matches)
+                return result;
+        }
+        return nullopt;
+    }
+
+    root_name_set root_names() const { return match::root_names(m); }
+};
+
+template <class M, class Pack>
+sub_matcher<M, Pack> make_sub_matcher(M m, Pack ms)
+{
+    return {m, ms};
+}
+
 /// The basic matcher provides the all_of composability of the matcher
 template <class M>
 struct basic_matcher
@@ -226,25 +324,14 @@ struct basic_matcher
     template <class... Ts>
     auto operator()(Ts... ms) const
     {
-        // Copy m because we cant capture `this` by value
-        auto mm = m;
-        return make_basic_fun_matcher([=](matcher_context& ctx,
-                                          instruction_ref ins) -> optional<instruction_ref> {
-            auto result = mm.match(ctx, ins);
-            if(result)
-            {
-                bool matches =
-                    fold([&](auto x, auto y) { return x and ctx.matched(y, result); })(true, ms...);
-                if(matches)
-                    return result;
-            }
-            return nullopt;
-        });
+        return make_basic_matcher(make_sub_matcher(m, pack(ms...)));
     }
 
     auto bind(std::string name) const { return bind_match(m, std::move(name)); }
 
     auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    root_name_set root_names() const { return match::root_names(m); }
 };
 
 /// Create a typed-erased matcher
@@ -253,9 +340,16 @@ using any_matcher_base = basic_matcher<
 struct any_matcher : any_matcher_base
 {
     template <class M>
-    any_matcher(M mm) : any_matcher_base({[=](auto& ctx, auto ins) { return mm.match(ctx, ins); }})
+    any_matcher(M mm)
+        : any_matcher_base({[=](auto& ctx, auto ins) { return mm.match(ctx, ins); }}),
+          names(match::root_names(mm))
     {
     }
+
+    root_name_set root_names() const { return names; }
+
+    private:
+    root_name_set names;
 };
 
 /// Create a basic matcher from a matcher
@@ -374,63 +468,184 @@ match::matcher_result find_match(module& modl, M&& m)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_MATCHES)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_MATCHES_FOR)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_VALIDATE_MATCHES)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TIME_MATCHES)
+
+/// Settings for finding matches which are read from the environment once
+struct find_matches_settings
+{
+    int trace                = value_of(MIGRAPHX_TRACE_MATCHES{});
+    bool validate            = enabled(MIGRAPHX_VALIDATE_MATCHES{});
+    bool time                = enabled(MIGRAPHX_TIME_MATCHES{});
+    std::string trace_filter = string_value_of(MIGRAPHX_TRACE_MATCHES_FOR{});
+
+    bool needs_names() const { return trace > 0 or time or not trace_filter.empty(); }
+};
+
+/// Per matcher information and counters collected while finding matches
+struct matcher_stats
+{
+    std::string name;
+    bool trace_for       = false;
+    std::size_t attempts = 0;
+    std::size_t hits     = 0;
+    double time          = 0;
+};
+
+template <class M>
+matcher_stats make_matcher_stats(source_location location,
+                                 const find_matches_settings& settings,
+                                 const M& m)
+{
+    matcher_stats stats;
+    if(not settings.needs_names())
+        return stats;
+    stats.name = get_type_name(m);
+    stats.trace_for =
+        not settings.trace_filter.empty() and
+        (contains(std::string{location.file_name()}, settings.trace_filter) or
+         contains(std::string{location.function_name()}, settings.trace_filter) or
+         contains(stats.name, settings.trace_filter));
+    return stats;
+}
+
+inline void print_matcher_stats(source_location location,
+                                const matcher_stats* first,
+                                const matcher_stats* last)
+{
+    std::cout << "Matcher stats for " << location.function_name() << ":" << std::endl;
+    std::for_each(first, last, [](const matcher_stats& stats) {
+        std::cout << "    " << stats.name << ": " << stats.hits << "/" << stats.attempts
+                  << " matched, " << stats.time << "ms" << std::endl;
+    });
+}
+
+/// Try to match and apply a single matcher on an instruction, returns true if it matched
+template <class Mod, class M>
+bool try_match_apply(const find_matches_settings& settings,
+                     matcher_stats& stats,
+                     Mod& mod,
+                     instruction_ref ins,
+                     M&& m)
+{
+    timer t{};
+    if(settings.trace > 1 and stats.trace_for)
+        std::cout << "Match: " << stats.name << std::endl;
+    stats.attempts++;
+    auto r = match_instruction(get_module(mod), ins, m.matcher());
+    if(r.result == get_module(mod).end())
+    {
+        if(settings.time)
+            stats.time += t.record<std::chrono::duration<double, std::milli>>();
+        return false;
+    }
+    if(settings.trace > 0 or stats.trace_for)
+    {
+        std::cout << "Matched by " << stats.name << std::endl;
+        get_module(mod).debug_print(ins);
+    }
+    // If its already invalid dont validate it again
+    bool invalidated =
+        settings.validate and get_module(mod).validate() != get_module(mod).end();
+    m.apply(mod, r);
+    if(settings.validate and not invalidated)
+    {
+        auto invalid = get_module(mod).validate();
+        if(invalid != get_module(mod).end())
+        {
+            std::cout << "Invalid program from match: " << stats.name << std::endl;
+            std::cout << "Invalid instructions: " << std::endl;
+            get_module(mod).debug_print(invalid->inputs());
+            get_module(mod).debug_print(invalid);
+        }
+    }
+    stats.hits++;
+    if(settings.time)
+        stats.time += t.record<std::chrono::duration<double, std::milli>>();
+    return true;
+}
 
 /// Find matches for an instruction in the module for per section of matchers
 template <class Mod, class... Ms>
 void find_matches_for(source_location location, Mod& mod, instruction_ref ins, Ms&&... ms)
 {
-    const int trace         = value_of(MIGRAPHX_TRACE_MATCHES{});
-    const bool validate     = enabled(MIGRAPHX_VALIDATE_MATCHES{});
-    const auto trace_filter = string_value_of(MIGRAPHX_TRACE_MATCHES_FOR{});
-    bool match              = false;
+    const find_matches_settings settings{};
+    bool match = false;
     each_args(
         [&](auto&& m) {
-            const auto& matcher_name = get_type_name(m);
-            const bool trace_for     = not trace_filter.empty() and
-                                   (contains(std::string{location.file_name()}, trace_filter) or
-                                    contains(std::string{location.function_name()}, trace_filter) or
-                                    contains(matcher_name, trace_filter));
             if(match)
                 return;
-            if(trace > 1 and trace_for)
-                std::cout << "Match: " << matcher_name << std::endl;
-            auto r = match_instruction(get_module(mod), ins, m.matcher());
-            if(r.result == get_module(mod).end())
-                return;
-            if(trace > 0 or trace_for)
-            {
-                std::cout << "Matched by " << matcher_name << std::endl;
-                get_module(mod).debug_print(ins);
-            }
-            // If its already invalid dont validate it again
-            bool invalidated = validate and get_module(mod).validate() != get_module(mod).end();
-            m.apply(mod, r);
-            if(validate and not invalidated)
-            {
-                auto invalid = get_module(mod).validate();
-                if(invalid != get_module(mod).end())
-                {
-                    std::cout << "Invalid program from match: " << matcher_name << std::endl;
-                    std::cout << "Invalid instructions: " << std::endl;
-                    get_module(mod).debug_print(invalid->inputs());
-                    get_module(mod).debug_print(invalid);
-                }
-            }
-            match = true;
+            auto stats = make_matcher_stats(location, settings, m);
+            match      = try_match_apply(settings, stats, mod, ins, m);
         },
         ms...);
 }
 
+/// Index of the matchers that can match an instruction based on the operator
+/// name of the root instruction
+struct root_name_index
+{
+    template <class... Ms>
+    root_name_index(const Ms&... ms)
+    {
+        std::vector<root_name_set> names = {match::root_names(ms.matcher())...};
+        std::transform(names.begin(),
+                       names.end(),
+                       std::back_inserter(any_candidates),
+                       [](const auto& n) { return not n.has_value(); });
+        for(std::size_t i = 0; i < names.size(); i++)
+        {
+            if(not names[i])
+                continue;
+            for(const auto& name : *names[i])
+            {
+                auto it = index.emplace(name, any_candidates).first;
+                it->second[i] = true;
+            }
+        }
+    }
+
+    /// Get a flag for each matcher to indicate if it should be tried on the instruction
+    const std::vector<bool>& candidates(instruction_ref ins) const
+    {
+        if(index.empty())
+            return any_candidates;
+        auto it = index.find(ins->name());
+        if(it == index.end())
+            return any_candidates;
+        return it->second;
+    }
+
+    private:
+    std::vector<bool> any_candidates;
+    std::unordered_map<std::string, std::vector<bool>> index;
+};
+
 /// Find matches in a module
 template <class Mod, class... Ms>
 struct find_matches
 {
     find_matches(Mod& mod, Ms&&... ms, source_location location = source_location::current())
     {
+        const find_matches_settings settings{};
+        const root_name_index index{ms...};
+        std::array<matcher_stats, sizeof...(Ms)> stats = {
+            make_matcher_stats(location, settings, ms)...};
         for(auto ins : iterator_for(get_module(mod)))
         {
-            find_matches_for(location, mod, ins, ms...);
+            const auto& candidates = index.candidates(ins);
+            std::size_t i          = 0;
+            bool match             = false;
+            each_args(
+                [&](auto&& m) {
+                    auto n = i++;
+                    if(match or not candidates[n])
+                        return;
+                    match = try_match_apply(settings, stats[n], mod, ins, m);
+                },
+                ms...);
         }
+        if(settings.time)
+            print_matcher_stats(location, stats.data(), stats.data() + stats.size());
     }
 };
 
@@ -504,15 +719,43 @@ struct match_fold_f
     }
 
     template <class... Ts>
-    auto operator()(Ts... ms) const
+    static root_name_set fold_root_names(Ts... names)
     {
-        return make_bf_matcher(
-            [=](matcher_context& ctx, instruction_ref ins) -> optional<instruction_ref> {
-                bool matches = match_fold_f::fold_matchers(ctx, ins, ms...);
-                if(matches == Matches)
-                    return {ins};
-                return nullopt;
+        // The inverse of a match can have any name
+        if(not Matches)
+            return nullopt;
+        if(std::is_same<Op, lazy_and>{})
+            return fold(&intersect_root_names)(root_name_set{}, names...);
+        return fold(&union_root_names)(root_name_set{std::unordered_set<std::string>{}},
+                                       names...);
+    }
+
+    template <class Pack>
+    struct fold_matcher
+    {
+        Pack ms;
+
+        optional<instruction_ref> match(matcher_context& ctx, instruction_ref ins) const
+        {
+            bool matches = match_fold_f::fold_matchers_pack(ctx, ins, ms);
+            if(matches == Matches)
+                return {ins};
+            return nullopt;
+        }
+
+        root_name_set root_names() const
+        {
+            return ms([](const auto&... xs) {
+                return match_fold_f::fold_root_names(match::root_names(xs)...);
             });
+        }
+    };
+
+    template <class... Ts>
+    auto operator()(Ts... ms) const
+    {
+        auto mpack = pack(ms...);
+        return make_bindable_matcher(fold_matcher<decltype(mpack)>{mpack});
     }
 
     template <class Selector>
@@ -688,11 +931,37 @@ inline auto var(std::string s)
         });
 }
 
-inline auto name(std::string s)
+/// Match the operator name of the instruction
+struct name_matcher
 {
-    return make_basic_pred_matcher(
-        [=, m_s = std::move(s)](instruction_ref ins) { return ins->name() == m_s; });
-}
+    std::string name;
+
+    optional<instruction_ref> match(const matcher_context&, instruction_ref ins) const
+    {
+        if(ins->name() == name)
+            return ins;
+        return nullopt;
+    }
+
+    root_name_set root_names() const { return std::unordered_set<std::string>{name}; }
+};
+
+/// Match the operator name of the instruction against a set of names
+struct names_matcher
+{
+    std::unordered_set<std::string> names;
+
+    optional<instruction_ref> match(const matcher_context&, instruction_ref ins) const
+    {
+        if(names.count(ins->name()) > 0)
+            return ins;
+        return nullopt;
+    }
+
+    root_name_set root_names() const { return names; }
+};
+
+inline auto name(std::string s) { return make_basic_matcher(name_matcher{std::move(s)}); }
 
 inline auto name_contains(const std::string& name)
 {
@@ -702,9 +971,7 @@ inline auto name_contains(const std::string& name)
 
 inline auto name(std::unordered_set<std::string> names)
 {
-    return make_basic_pred_matcher([=, m_names = std::move(names)](instruction_ref ins) {
-        return m_names.count(ins->name()) > 0;
-    });
+    return make_basic_matcher(names_matcher{std::move(names)});
 }
 
 template <class... Ts>
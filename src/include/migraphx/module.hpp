@@ -181,6 +181,12 @@ struct MIGRAPHX_EXPORT module
 
     bool has_instruction(instruction_ref ins) const;
 
+    /* Returns a counter that is incremented every time an instruction is inserted, replaced,
+     * moved or removed from the module. Passes can compare the counter before and after
+     * running to detect whether the module was changed.
+     */
+    std::size_t get_change_count() const;
+
     std::vector<instruction_ref> get_returns() const;
 
     std::size_t size() const;
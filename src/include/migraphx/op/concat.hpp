@@ -26,6 +26,7 @@
 
 #include <array>
 #include <migraphx/check_shapes.hpp>
+#include <migraphx/copy_layout.hpp>
 #include <migraphx/dyn_output.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/streamutils.hpp>
@@ -149,14 +150,14 @@ struct concat
         std::vector<std::size_t> coffsets = compute_offsets(dyn_out.computed_shape, args);
         for(std::size_t l = 0; l < args.size(); l++)
         {
-            auto argl = args[l];
-            visit_all(result, argl)([&](auto output, auto input) {
-                auto slice_shape = shape{dyn_out.computed_shape.type(),
-                                         input.get_shape().lens(),
-                                         dyn_out.computed_shape.strides()};
-                auto slice       = make_view(slice_shape, output.data() + coffsets[l]);
-                std::copy(input.begin(), input.end(), slice.begin());
-            });
+            const auto& argl = args[l];
+            auto slice_shape = shape{dyn_out.computed_shape.type(),
+                                     argl.get_shape().lens(),
+                                     dyn_out.computed_shape.strides()};
+            copy_layout(argl.get_shape(),
+                        argl.data(),
+                        slice_shape,
+                        result.data() + coffsets[l] * slice_shape.type_size());
         }
         return result;
     }
@@ -26,7 +26,7 @@
 
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/argument.hpp>
-#include <migraphx/shape_for_each.hpp>
+#include <migraphx/copy_layout.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/dyn_output.hpp>
 
@@ -64,11 +64,7 @@ struct contiguous
     {
         assert(dyn_out.computed_shape.standard());
         argument result{dyn_out.computed_shape};
-        visit_all(result, args[0])([&](auto output, auto input) {
-            shape_for_each(output.get_shape(), [&](const auto& idx) {
-                output(idx.begin(), idx.end()) = input(idx.begin(), idx.end());
-            });
-        });
+        copy_layout(args[0], result);
         return result;
     }
 
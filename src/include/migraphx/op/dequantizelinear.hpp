@@ -27,9 +27,11 @@
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/argument.hpp>
-#include <migraphx/par_for.hpp>
+#include <migraphx/shape_for_each.hpp>
 #include <migraphx/value.hpp>
+#include <algorithm>
 #include <cmath>
+#include <type_traits>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -59,23 +61,48 @@ struct dequantizelinear
 
     argument compute(const shape& output_shape, std::vector<argument> args) const
     {
-        auto x       = args.at(0);
-        auto x_scale = args.at(1);
-        std::vector<int8_t> zeros(output_shape.bytes(), 0);
-        argument x_zero_point{{x.get_shape().type(), output_shape.lens()}, zeros.data()};
-        if(args.size() == 3)
-        {
-            x_zero_point = args.at(2);
-        }
-
+        std::vector<shape> shapes = {output_shape};
+        std::transform(args.begin(), args.end(), std::back_inserter(shapes), [](const auto& a) {
+            return a.get_shape();
+        });
         argument result{output_shape};
-        visit_all(x, x_zero_point)([&](auto input, auto zero_pts) {
-            visit_all(result, x_scale)([&](auto output, auto scales) {
-                par_for(output_shape.elements(), [&](auto i) {
-                    output[i] = static_cast<double>(static_cast<double>(input[i]) -
-                                                    static_cast<double>(zero_pts[i])) *
-                                scales[i];
-                });
+        args[0].visit([&](auto input) {
+            visit_all(result, args[1])([&](auto output, auto scales) {
+                using quant_type   = typename decltype(input)::value_type;
+                using output_type  = typename decltype(output)::value_type;
+                using compute_type =
+                    std::conditional_t<(sizeof(output_type) > 4 or sizeof(quant_type) > 2),
+                                       double,
+                                       float>;
+                const quant_type* zero_pts =
+                    args.size() == 3 ? args[2].template cast<quant_type>() : nullptr;
+                par_shape_for_each_row(
+                    shapes, [&](const auto& offsets, std::size_t n, const auto& strides) {
+                        auto* y       = output.data() + offsets[0];
+                        const auto* x = input.data() + offsets[1];
+                        const auto* s = scales.data() + offsets[2];
+                        const auto* z = zero_pts == nullptr ? nullptr : zero_pts + offsets[3];
+                        auto zstride  = zero_pts == nullptr ? 0 : strides[3];
+                        if(strides[0] == 1 and strides[1] == 1 and strides[2] == 0 and zstride == 0)
+                        {
+                            // Scalar or per-axis scale that is constant across the row
+                            auto scale   = static_cast<compute_type>(s[0]);
+                            auto zero_pt = z == nullptr ? 0 : static_cast<compute_type>(z[0]);
+                            for(std::size_t j = 0; j < n; j++)
+                                y[j] = (static_cast<compute_type>(x[j]) - zero_pt) * scale;
+                        }
+                        else
+                        {
+                            for(std::size_t j = 0; j < n; j++)
+                            {
+                                auto zero_pt =
+                                    z == nullptr ? 0 : static_cast<compute_type>(z[j * zstride]);
+                                y[j * strides[0]] =
+                                    (static_cast<compute_type>(x[j * strides[1]]) - zero_pt) *
+                                    static_cast<compute_type>(s[j * strides[2]]);
+                            }
+                        }
+                    });
             });
         });
 
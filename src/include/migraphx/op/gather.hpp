@@ -122,16 +122,22 @@ struct gather
                 }
                 else
                 {
-                    auto out_lens  = data.get_shape().lens();
-                    out_lens[axis] = indices.get_shape().elements();
-                    migraphx::shape out_comp_shape{data.get_shape().type(), out_lens};
-                    shape_for_each(out_comp_shape, [&](const auto& out_idx_v, size_t out_idx) {
-                        auto data_idx   = out_idx_v;
-                        auto in_index   = indices[data_idx[axis]];
-                        in_index        = (in_index < 0) ? in_index + axis_dim_size : in_index;
-                        data_idx[axis]  = in_index;
-                        output[out_idx] = data(data_idx.begin(), data_idx.end());
-                    });
+                    const auto& data_shape = data.get_shape();
+                    auto out_lens          = data_shape.lens();
+                    out_lens[axis]         = indices.get_shape().elements();
+                    migraphx::shape out_comp_shape{data_shape.type(), out_lens};
+                    // Walk the data without the gathered axis, which is added per element
+                    auto data_strides  = data_shape.strides();
+                    auto axis_stride   = data_strides[axis];
+                    data_strides[axis] = 0;
+                    migraphx::shape data_comp_shape{data_shape.type(), out_lens, data_strides};
+                    par_shape_for_each_offset(
+                        {out_comp_shape, data_comp_shape},
+                        [&](const auto& out_idx_v, const auto& offsets) {
+                            auto i               = indices[out_idx_v[axis]];
+                            std::size_t in_index = (i < 0) ? i + axis_dim_size : i;
+                            output[offsets[0]]   = data.data()[offsets[1] + in_index * axis_stride];
+                        });
                 }
             });
         });
@@ -27,9 +27,11 @@
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/argument.hpp>
-#include <migraphx/par_for.hpp>
+#include <migraphx/shape_for_each.hpp>
 #include <migraphx/value.hpp>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <fenv.h>
 
 namespace migraphx {
@@ -63,33 +65,74 @@ struct quantizelinear
 
     argument compute(const shape& output_shape, std::vector<argument> args) const
     {
-        auto x       = args.at(0);
-        auto y_scale = args.at(1);
-        std::vector<int8_t> zeros(output_shape.bytes(), 0);
-        argument y_zero_point{output_shape, zeros.data()};
-        if(args.size() == 3)
-        {
-            y_zero_point = args.at(2);
-        }
+        std::vector<shape> shapes = {output_shape};
+        std::transform(args.begin(), args.end(), std::back_inserter(shapes), [](const auto& a) {
+            return a.get_shape();
+        });
         argument result{output_shape};
-        auto rounding_mode = fegetround();
-        fesetround(FE_TONEAREST);
-        visit_all(result, y_zero_point)([&](auto output, auto zero_pts) {
-            visit_all(x, y_scale)([&](auto input, auto scales) {
+        rounding_guard guard{};
+        visit_all(args[0], args[1])([&](auto input, auto scales) {
+            result.visit([&](auto output) {
+                using input_type = typename decltype(input)::value_type;
                 using quant_type = typename decltype(output)::value_type;
-                auto min_value   = std::numeric_limits<quant_type>::min();
-                auto max_value   = std::numeric_limits<quant_type>::max();
-                par_for(output_shape.elements(), [&](auto i) {
-                    double quantized = static_cast<double>(std::nearbyint(input[i] / scales[i])) +
-                                       static_cast<double>(zero_pts[i]);
-                    output[i] = std::max(static_cast<double>(min_value),
-                                         std::min(static_cast<double>(max_value), quantized));
-                });
+                using compute_type =
+                    std::conditional_t<(sizeof(input_type) > 4 or sizeof(quant_type) > 2),
+                                       double,
+                                       float>;
+                const quant_type* zero_pts =
+                    args.size() == 3 ? args[2].template cast<quant_type>() : nullptr;
+                compute_type min_value = std::numeric_limits<quant_type>::lowest();
+                compute_type max_value = std::numeric_limits<quant_type>::max();
+
+                auto quantize = [&](compute_type x, compute_type scale, compute_type zero_pt) {
+                    compute_type q = x / scale;
+                    // Float outputs such as fp8 are rounded by the conversion
+                    if constexpr(std::is_integral<quant_type>{})
+                        q = std::nearbyint(q);
+                    return static_cast<quant_type>(
+                        std::min(max_value, std::max(min_value, q + zero_pt)));
+                };
+                par_shape_for_each_row(
+                    shapes, [&](const auto& offsets, std::size_t n, const auto& strides) {
+                        auto* y       = output.data() + offsets[0];
+                        const auto* x = input.data() + offsets[1];
+                        const auto* s = scales.data() + offsets[2];
+                        const auto* z = zero_pts == nullptr ? nullptr : zero_pts + offsets[3];
+                        auto zstride  = zero_pts == nullptr ? 0 : strides[3];
+                        if(strides[0] == 1 and strides[1] == 1 and strides[2] == 0 and zstride == 0)
+                        {
+                            // Scalar or per-axis scale that is constant across the row
+                            auto scale   = static_cast<compute_type>(s[0]);
+                            auto zero_pt = z == nullptr ? 0 : static_cast<compute_type>(z[0]);
+                            for(std::size_t j = 0; j < n; j++)
+                                y[j] = quantize(x[j], scale, zero_pt);
+                        }
+                        else
+                        {
+                            for(std::size_t j = 0; j < n; j++)
+                            {
+                                auto zero_pt =
+                                    z == nullptr ? 0 : static_cast<compute_type>(z[j * zstride]);
+                                y[j * strides[0]] =
+                                    quantize(x[j * strides[1]], s[j * strides[2]], zero_pt);
+                            }
+                        }
+                    });
             });
         });
-        fesetround(rounding_mode);
         return result;
     }
+
+    private:
+    // nearbyint rounds half to even only in the default rounding mode
+    struct rounding_guard
+    {
+        int mode = fegetround();
+        rounding_guard() { fesetround(FE_TONEAREST); }
+        rounding_guard(const rounding_guard&)            = delete;
+        rounding_guard& operator=(const rounding_guard&) = delete;
+        ~rounding_guard() { fesetround(mode); }
+    };
 };
 } // namespace op
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,309 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_RESIZE_HPP
+#define MIGRAPHX_GUARD_OPERATORS_RESIZE_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/copy_layout.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Resize a tensor with nearest, linear or cubic interpolation following the ONNX Resize
+ * operator. The output size is given either by `sizes` or by `scales`. The source coordinates are
+ * computed while running, one axis at a time, so no index tensors are needed.
+ */
+struct resize
+{
+    std::vector<float> scales                  = {};
+    std::vector<std::size_t> sizes             = {};
+    std::string mode                           = "nearest";
+    std::string coordinate_transformation_mode = "half_pixel";
+    std::string nearest_mode                   = "round_prefer_floor";
+    float cubic_coeff_a                        = -0.75f;
+    bool exclude_outside                       = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.scales, "scales"),
+                    f(self.sizes, "sizes"),
+                    f(self.mode, "mode"),
+                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"),
+                    f(self.nearest_mode, "nearest_mode"),
+                    f(self.cubic_coeff_a, "cubic_coeff_a"),
+                    f(self.exclude_outside, "exclude_outside"));
+    }
+
+    std::string name() const { return "resize"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(1);
+        const auto& input = inputs.front();
+        if(input.dynamic())
+            MIGRAPHX_THROW("RESIZE: dynamic input shape is not supported");
+        if(not contains({"nearest", "linear", "cubic"}, mode))
+            MIGRAPHX_THROW("RESIZE: unsupported mode: " + mode);
+        if(not contains({"half_pixel",
+                         "pytorch_half_pixel",
+                         "align_corners",
+                         "asymmetric",
+                         "tf_half_pixel_for_nn"},
+                        coordinate_transformation_mode))
+            MIGRAPHX_THROW("RESIZE: unsupported coordinate_transformation_mode: " +
+                           coordinate_transformation_mode);
+        if(not contains({"round_prefer_floor", "round_prefer_ceil", "floor", "ceil"},
+                        nearest_mode))
+            MIGRAPHX_THROW("RESIZE: unsupported nearest_mode: " + nearest_mode);
+        auto lens = input.lens();
+        if(not sizes.empty())
+        {
+            if(sizes.size() != lens.size())
+                MIGRAPHX_THROW("RESIZE: sizes do not match the rank of the input");
+            return {input.type(), sizes};
+        }
+        if(scales.size() != lens.size())
+            MIGRAPHX_THROW("RESIZE: scales do not match the rank of the input");
+        std::transform(
+            lens.begin(), lens.end(), scales.begin(), lens.begin(), [](auto len, auto scale) {
+                return static_cast<std::size_t>(len * static_cast<double>(scale));
+            });
+        return {input.type(), lens};
+    }
+
+    double get_scale(std::size_t axis, std::size_t in_len, std::size_t out_len) const
+    {
+        if(not scales.empty())
+            return scales[axis];
+        return 1.0 * out_len / in_len;
+    }
+
+    // Position in the input of the output index along one axis
+    double original_coordinate(std::size_t in_len,
+                               std::size_t out_len,
+                               std::size_t idx,
+                               double scale) const
+    {
+        const auto& m = coordinate_transformation_mode;
+        if(m == "pytorch_half_pixel")
+            return out_len > 1 ? (idx + 0.5) / scale - 0.5 : 0.0;
+        if(m == "align_corners")
+            return (out_len == 1) ? 0.0 : (1.0 * idx * (in_len - 1.0) / (out_len - 1.0));
+        if(m == "asymmetric")
+            return idx / scale;
+        if(m == "tf_half_pixel_for_nn")
+            return (idx + 0.5) / scale;
+        return (idx + 0.5) / scale - 0.5;
+    }
+
+    std::size_t nearest_index(std::size_t in_len, double x) const
+    {
+        x = std::max(0.0, std::min(in_len - 1.0, x));
+        if(nearest_mode == "round_prefer_ceil")
+            return std::round(x);
+        if(nearest_mode == "floor")
+            return std::floor(x);
+        if(nearest_mode == "ceil")
+            return std::ceil(x);
+        return std::ceil(x - 0.5);
+    }
+
+    std::size_t taps() const
+    {
+        if(mode == "linear")
+            return 2;
+        if(mode == "cubic")
+            return 4;
+        return 1;
+    }
+
+    // Input indices and weights used to compute each output index along one axis
+    struct axis_weights
+    {
+        std::size_t taps = 1;
+        std::vector<std::size_t> indices;
+        std::vector<double> weights;
+
+        bool identity() const
+        {
+            for(std::size_t j = 0; j < indices.size() / taps; j++)
+            {
+                for(std::size_t k = 0; k < taps; k++)
+                {
+                    auto w = weights[j * taps + k];
+                    if(w == 0.0)
+                        continue;
+                    if(w != 1.0 or indices[j * taps + k] != j)
+                        return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    axis_weights compute_axis_weights(std::size_t in_len, std::size_t out_len, double scale) const
+    {
+        axis_weights result;
+        result.taps = taps();
+        result.indices.resize(out_len * result.taps);
+        result.weights.resize(out_len * result.taps);
+        const double a = cubic_coeff_a;
+        for(std::size_t j = 0; j < out_len; j++)
+        {
+            auto x        = original_coordinate(in_len, out_len, j, scale);
+            auto* indices = result.indices.data() + j * result.taps;
+            auto* weights = result.weights.data() + j * result.taps;
+            if(mode == "nearest")
+            {
+                indices[0] = nearest_index(in_len, x);
+                weights[0] = 1.0;
+            }
+            else if(mode == "linear")
+            {
+                x          = std::max(0.0, std::min(in_len - 1.0, x));
+                indices[0] = std::floor(x);
+                indices[1] = std::min<std::size_t>(indices[0] + 1, in_len - 1);
+                weights[1] = x - indices[0];
+                weights[0] = 1.0 - weights[1];
+            }
+            else
+            {
+                auto x0    = static_cast<std::ptrdiff_t>(std::floor(x));
+                auto r     = x - x0;
+                auto n     = static_cast<std::ptrdiff_t>(in_len);
+                double sum = 0.0;
+                std::array<double, 4> d = {r + 1.0, r, 1.0 - r, 2.0 - r};
+                for(std::size_t k = 0; k < 4; k++)
+                {
+                    // Keys cubic convolution kernel
+                    auto t   = d[k];
+                    double w = (t <= 1.0) ? ((a + 2.0) * t - (a + 3.0)) * t * t + 1.0
+                                          : ((a * t - 5.0 * a) * t + 8.0 * a) * t - 4.0 * a;
+                    auto pos = x0 - 1 + static_cast<std::ptrdiff_t>(k);
+                    if(exclude_outside and (pos < 0 or pos >= n))
+                        w = 0.0;
+                    indices[k] = std::max<std::ptrdiff_t>(0, std::min(pos, n - 1));
+                    weights[k] = w;
+                    sum += w;
+                }
+                if(exclude_outside and sum != 0.0)
+                    std::transform(weights, weights + 4, weights, [&](auto w) { return w / sum; });
+            }
+        }
+        return result;
+    }
+
+    // Resample one axis of a standard tensor
+    static argument resize_axis(const argument& input, std::size_t axis, const axis_weights& aw)
+    {
+        auto in_lens   = input.get_shape().lens();
+        auto out_lens  = in_lens;
+        out_lens[axis] = aw.indices.size() / aw.taps;
+        argument result{shape{input.get_shape().type(), out_lens}};
+        auto outer = std::accumulate(
+            in_lens.begin(), in_lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+        auto inner = std::accumulate(
+            in_lens.begin() + axis + 1, in_lens.end(), std::size_t{1}, std::multiplies<>{});
+        auto in_len  = in_lens[axis];
+        auto out_len = out_lens[axis];
+        visit_all(result, input)([&](auto output, auto x) {
+            using type = typename decltype(output)::value_type;
+            par_for(outer * out_len, [&](auto i) {
+                auto o       = i / out_len;
+                auto j       = i % out_len;
+                auto* dst    = output.data() + i * inner;
+                const auto* indices = aw.indices.data() + j * aw.taps;
+                const auto* weights = aw.weights.data() + j * aw.taps;
+                if(aw.taps == 1)
+                {
+                    const auto* src = x.data() + (o * in_len + indices[0]) * inner;
+                    std::copy(src, src + inner, dst);
+                    return;
+                }
+                for(std::size_t e = 0; e < inner; e++)
+                {
+                    double acc = 0.0;
+                    for(std::size_t k = 0; k < aw.taps; k++)
+                        acc += weights[k] * x[(o * in_len + indices[k]) * inner + e];
+                    dst[e] = static_cast<type>(acc);
+                }
+            });
+        });
+        return result;
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        auto result = args.front();
+        if(not result.get_shape().standard())
+        {
+            argument standard{shape{result.get_shape().type(), result.get_shape().lens()}};
+            copy_layout(result, standard);
+            result = standard;
+        }
+        const auto& in_lens  = args.front().get_shape().lens();
+        const auto& out_lens = output_shape.lens();
+        // Shrink the tensor as early as possible so the later passes do less work
+        std::vector<std::size_t> axes(in_lens.size());
+        std::iota(axes.begin(), axes.end(), 0);
+        std::stable_sort(axes.begin(), axes.end(), [&](auto x, auto y) {
+            return out_lens[x] * in_lens[y] < out_lens[y] * in_lens[x];
+        });
+        for(auto axis : axes)
+        {
+            auto aw = compute_axis_weights(
+                in_lens[axis], out_lens[axis], get_scale(axis, in_lens[axis], out_lens[axis]));
+            if(in_lens[axis] == out_lens[axis] and aw.identity())
+                continue;
+            result = resize_axis(result, axis, aw);
+        }
+        // The input is returned directly when nothing is resized
+        if(result.data() == args.front().data())
+        {
+            argument copy{output_shape};
+            copy_layout(result, copy);
+            return copy;
+        }
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -70,7 +70,7 @@ struct reverse
         argument result{s};
         auto lens = s.lens();
         visit_all(result, args.front())([&](auto output, auto input) {
-            shape_for_each(s, [&](const auto& out_idx_v, size_t out_idx) {
+            par_shape_for_each(s, [&](const auto& out_idx_v, size_t out_idx) {
                 auto in_idx = out_idx_v;
                 for(const auto& axis : axes)
                 {
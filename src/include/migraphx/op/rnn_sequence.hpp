@@ -0,0 +1,441 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_RNN_SEQUENCE_HPP
+#define MIGRAPHX_GUARD_OPERATORS_RNN_SEQUENCE_HPP
+
+#include <migraphx/op/common.hpp>
+#include <migraphx/op/gru.hpp>
+#include <migraphx/op/lstm.hpp>
+#include <migraphx/op/rnn.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/config.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Evaluates an rnn, gru or lstm operator over the whole sequence without unrolling it into the
+ * graph. The projection of the input is computed for all the timesteps at once, and then the
+ * hidden state is updated one timestep at a time. The output is a tuple of the hidden states,
+ * the last hidden state and, for lstm, the last cell state.
+ *
+ * The activation functions of the operator are expected to be listed for every direction, as done
+ * by rewrite_rnn.
+ */
+struct rnn_sequence
+{
+    operation op = op::rnn{};
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+
+    std::string name() const { return "rnn_sequence"; }
+
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has_at_least(3);
+        auto hs_shape = op.compute_shape(inputs);
+        auto lens     = hs_shape.lens();
+        lens.erase(lens.begin());
+        shape last_shape{hs_shape.type(), lens};
+        if(op.name() == "lstm")
+            return shape{{hs_shape, last_shape, last_shape}};
+        return shape{{hs_shape, last_shape}};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        std::vector<argument> results;
+        for(const auto& s : output_shape.sub_shapes())
+            results.emplace_back(s);
+        results.front().visit([&](auto output) {
+            using type    = typename decltype(output)::value_type;
+            using compute_type = std::common_type_t<type, float>;
+            rnn_data<compute_type> data{};
+            data.init(*this, args);
+            for(std::size_t d = 0; d < data.num_directions; d++)
+                data.run(d);
+            for(std::size_t i = 0; i < results.size(); i++)
+            {
+                results[i].visit([&](auto r) {
+                    std::copy(data.outputs[i].begin(), data.outputs[i].end(), r.begin());
+                });
+            }
+        });
+        return {results};
+    }
+
+    value to_value() const
+    {
+        value v;
+        v["name"]     = op.name();
+        v["operator"] = op.to_value();
+        return v;
+    }
+
+    void from_value(const value& v)
+    {
+        op = make_op(v.at("name").to<std::string>(), v.at("operator"));
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const rnn_sequence& x)
+    {
+        os << x.name() << "::" << x.op;
+        return os;
+    }
+
+    private:
+    template <class T>
+    static std::vector<T> read_input(const std::vector<argument>& args, std::size_t i)
+    {
+        std::vector<T> result;
+        if(i < args.size() and not args[i].empty())
+            args[i].visit([&](auto v) { result.assign(v.begin(), v.end()); });
+        return result;
+    }
+
+    template <class T>
+    static void apply_actv(const operation& f, std::vector<T>& x)
+    {
+        shape s{shape::get_type<T>{}, {x.size()}};
+        auto result = f.compute(s, {argument{s, x.data()}});
+        result.visit([&](auto y) { std::copy(y.begin(), y.end(), x.begin()); });
+    }
+
+    template <class T>
+    struct rnn_data
+    {
+        std::string name;
+        std::vector<operation> actv_funcs;
+        rnn_direction direction = rnn_direction::forward;
+        int linear_before_reset = 0;
+
+        std::size_t num_directions = 1;
+        std::size_t seq_len        = 0;
+        std::size_t batch_size     = 0;
+        std::size_t input_size     = 0;
+        std::size_t hidden_size    = 0;
+        std::size_t num_gates      = 1;
+
+        std::vector<T> x;
+        std::vector<T> w;
+        std::vector<T> r;
+        std::vector<T> bias;
+        std::vector<std::size_t> seq_lens;
+        std::vector<T> ih;
+        std::vector<T> ic;
+        std::vector<T> pph;
+
+        // Hidden states, last hidden state and last cell state
+        std::vector<std::vector<T>> outputs;
+
+        void init(const rnn_sequence& self, const std::vector<argument>& args)
+        {
+            name = self.op.name();
+            if(name == "lstm")
+            {
+                auto lstm_op = any_cast<op::lstm>(self.op);
+                actv_funcs   = lstm_op.actv_funcs;
+                direction    = lstm_op.direction;
+                num_gates    = 4;
+            }
+            else if(name == "gru")
+            {
+                auto gru_op         = any_cast<op::gru>(self.op);
+                actv_funcs          = gru_op.actv_funcs;
+                direction           = gru_op.direction;
+                linear_before_reset = gru_op.linear_before_reset;
+                num_gates           = 3;
+            }
+            else
+            {
+                auto rnn_op = any_cast<op::rnn>(self.op);
+                actv_funcs  = rnn_op.actv_funcs;
+                direction   = rnn_op.direction;
+            }
+            if(direction == rnn_direction::bidirectional)
+                num_directions = 2;
+
+            auto x_lens = args[0].get_shape().lens();
+            seq_len     = x_lens[0];
+            batch_size  = x_lens[1];
+            input_size  = x_lens[2];
+            hidden_size = args[2].get_shape().lens()[2];
+
+            x    = read_input<T>(args, 0);
+            w    = read_input<T>(args, 1);
+            r    = read_input<T>(args, 2);
+            bias = read_input<T>(args, 3);
+            ih   = read_input<T>(args, 5);
+            ic   = read_input<T>(args, 6);
+            pph  = read_input<T>(args, 7);
+
+            seq_lens = read_input<std::size_t>(args, 4);
+            if(seq_lens.empty())
+                seq_lens.resize(batch_size, seq_len);
+            std::transform(seq_lens.begin(), seq_lens.end(), seq_lens.begin(), [&](auto l) {
+                return std::min(l, seq_len);
+            });
+
+            auto state_size = num_directions * batch_size * hidden_size;
+            if(ih.empty())
+                ih.resize(state_size, T(0));
+            if(ic.empty())
+                ic.resize(state_size, T(0));
+            outputs.emplace_back(seq_len * state_size, T(0));
+            outputs.emplace_back(state_size, T(0));
+            if(name == "lstm")
+                outputs.emplace_back(state_size, T(0));
+        }
+
+        const operation& actv_func(std::size_t d, std::size_t i) const
+        {
+            std::size_t n = num_gates == 1 ? 1 : num_gates - 1;
+            return actv_funcs.at(d * n + i);
+        }
+
+        // y[b, j] = sum_k a[b, k] * m[j, k]
+        void matmul_nt(const T* a, const T* m, std::size_t n, std::size_t k, std::vector<T>& y)
+            const
+        {
+            y.resize(batch_size * n);
+            for(std::size_t b = 0; b < batch_size; b++)
+            {
+                const T* arow = a + b * k;
+                for(std::size_t j = 0; j < n; j++)
+                {
+                    const T* mrow = m + j * k;
+                    T acc         = 0;
+                    for(std::size_t kk = 0; kk < k; kk++)
+                        acc += arow[kk] * mrow[kk];
+                    y[b * n + j] = acc;
+                }
+            }
+        }
+
+        // Ct = ft (.) Ct-1 + it (.) ct, and Ht = ot (.) h(Ct)
+        void lstm_step(std::size_t d,
+                       const T* pphd,
+                       const std::vector<T>& c,
+                       std::vector<std::vector<T>>& gates,
+                       std::vector<T>& cnew,
+                       std::vector<T>& hnew) const
+        {
+            std::size_t hs = hidden_size;
+            auto& it       = gates[0];
+            auto& ot       = gates[1];
+            auto& ft       = gates[2];
+            auto& ct       = gates[3];
+            if(pphd != nullptr)
+            {
+                for(std::size_t i = 0; i < it.size(); i++)
+                {
+                    it[i] += pphd[i % hs] * c[i];
+                    ft[i] += pphd[2 * hs + i % hs] * c[i];
+                }
+            }
+            apply_actv(actv_func(d, 0), it);
+            apply_actv(actv_func(d, 0), ft);
+            apply_actv(actv_func(d, 1), ct);
+            for(std::size_t i = 0; i < cnew.size(); i++)
+                cnew[i] = ft[i] * c[i] + it[i] * ct[i];
+            if(pphd != nullptr)
+            {
+                for(std::size_t i = 0; i < ot.size(); i++)
+                    ot[i] += pphd[hs + i % hs] * cnew[i];
+            }
+            apply_actv(actv_func(d, 0), ot);
+            hnew = cnew;
+            apply_actv(actv_func(d, 2), hnew);
+            for(std::size_t i = 0; i < hnew.size(); i++)
+                hnew[i] *= ot[i];
+        }
+
+        // Ht = (1 - zt) (.) ht + zt (.) Ht-1
+        void gru_step(std::size_t d,
+                      const T* rd,
+                      const T* rbd,
+                      const std::vector<T>& h,
+                      const std::vector<T>& hr,
+                      std::vector<std::vector<T>>& gates,
+                      std::vector<T>& hnew) const
+        {
+            std::size_t hs = hidden_size;
+            auto& zt       = gates[0];
+            auto& rt       = gates[1];
+            auto& ht       = gates[2];
+            apply_actv(actv_func(d, 0), zt);
+            apply_actv(actv_func(d, 0), rt);
+            if(linear_before_reset == 0)
+            {
+                std::vector<T> rt_h(h.size());
+                std::vector<T> rt_h_rh;
+                std::transform(
+                    rt.begin(), rt.end(), h.begin(), rt_h.begin(), [](T x, T y) { return x * y; });
+                matmul_nt(rt_h.data(), rd + 2 * hs * hs, hs, hs, rt_h_rh);
+                for(std::size_t i = 0; i < ht.size(); i++)
+                    ht[i] += rt_h_rh[i];
+            }
+            else
+            {
+                for(std::size_t i = 0; i < ht.size(); i++)
+                {
+                    auto b = i / hs;
+                    auto j = i % hs;
+                    T rh   = hr[b * 3 * hs + 2 * hs + j];
+                    if(rbd != nullptr)
+                        rh += rbd[2 * hs + j];
+                    ht[i] += rt[i] * rh;
+                }
+            }
+            apply_actv(actv_func(d, 1), ht);
+            for(std::size_t i = 0; i < hnew.size(); i++)
+                hnew[i] = (T(1) - zt[i]) * ht[i] + zt[i] * h[i];
+        }
+
+        void run(std::size_t d)
+        {
+            bool is_forward = direction == rnn_direction::forward or
+                              (direction == rnn_direction::bidirectional and d == 0);
+            bool is_gru       = name == "gru";
+            bool is_lstm      = name == "lstm";
+            std::size_t hs    = hidden_size;
+            std::size_t gsize = num_gates * hs;
+            const T* wd       = w.data() + d * gsize * input_size;
+            const T* rd       = r.data() + d * gsize * hs;
+            const T* wbd      = bias.empty() ? nullptr : bias.data() + d * 2 * gsize;
+            const T* rbd      = bias.empty() ? nullptr : wbd + gsize;
+            const T* pphd     = pph.empty() ? nullptr : pph.data() + d * 3 * hs;
+            // The hidden gate of gru multiplies the reset gate with the recurrent term, either
+            // before or after the gemm, so it is not added to the gate directly
+            bool rbh_separate  = is_gru and linear_before_reset != 0;
+            std::size_t radded = is_gru ? 2 * hs : gsize;
+            std::size_t rgates = (is_gru and not rbh_separate) ? 2 * hs : gsize;
+
+            // Compute the input projection and the biases for all the timesteps as one gemm
+            std::vector<T> xw(seq_len * batch_size * gsize);
+            par_for(seq_len * batch_size, [&](auto row) {
+                const T* xrow = x.data() + row * input_size;
+                for(std::size_t j = 0; j < gsize; j++)
+                {
+                    const T* wrow = wd + j * input_size;
+                    T acc         = 0;
+                    for(std::size_t i = 0; i < input_size; i++)
+                        acc += xrow[i] * wrow[i];
+                    if(wbd != nullptr)
+                    {
+                        acc += wbd[j];
+                        if(not rbh_separate or j < 2 * hs)
+                            acc += rbd[j];
+                    }
+                    xw[row * gsize + j] = acc;
+                }
+            });
+
+            auto state_begin = d * batch_size * hs;
+            std::vector<T> h(ih.begin() + state_begin, ih.begin() + state_begin + batch_size * hs);
+            std::vector<T> c(ic.begin() + state_begin, ic.begin() + state_begin + batch_size * hs);
+            std::vector<T> hr;
+            std::vector<std::vector<T>> gates(num_gates, std::vector<T>(batch_size * hs, T(0)));
+            std::vector<T> hnew(batch_size * hs);
+            std::vector<T> cnew(batch_size * hs);
+
+            auto max_len = *std::max_element(seq_lens.begin(), seq_lens.end());
+            for(std::size_t s = 0; s < max_len; s++)
+            {
+                auto active = [&](std::size_t b) { return s < seq_lens[b]; };
+                auto time   = [&](std::size_t b) { return is_forward ? s : seq_lens[b] - 1 - s; };
+
+                // Each batch reads the input projection of its own timestep since the reverse
+                // direction starts at the end of each sequence
+                matmul_nt(h.data(), rd, rgates, hs, hr);
+                for(std::size_t b = 0; b < batch_size; b++)
+                {
+                    if(not active(b))
+                        continue;
+                    const T* xwrow = xw.data() + (time(b) * batch_size + b) * gsize;
+                    const T* hrrow = hr.data() + b * rgates;
+                    for(std::size_t g = 0; g < num_gates; g++)
+                    {
+                        for(std::size_t j = 0; j < hs; j++)
+                        {
+                            auto k               = g * hs + j;
+                            gates[g][b * hs + j] = xwrow[k] + (k < radded ? hrrow[k] : T(0));
+                        }
+                    }
+                }
+
+                if(is_lstm)
+                {
+                    lstm_step(d, pphd, c, gates, cnew, hnew);
+                }
+                else if(is_gru)
+                {
+                    gru_step(d, rd, rbd, h, hr, gates, hnew);
+                }
+                else
+                {
+                    apply_actv(actv_func(d, 0), gates[0]);
+                    hnew = gates[0];
+                }
+
+                // Batches past the end of their sequence keep their state, and their hidden
+                // states stay zero
+                for(std::size_t b = 0; b < batch_size; b++)
+                {
+                    if(not active(b))
+                        continue;
+                    auto first = b * hs;
+                    auto last  = first + hs;
+                    auto* out  = outputs[0].data() +
+                                ((time(b) * num_directions + d) * batch_size + b) * hs;
+                    std::copy(hnew.begin() + first, hnew.begin() + last, out);
+                    std::copy(hnew.begin() + first, hnew.begin() + last, h.begin() + first);
+                    if(is_lstm)
+                        std::copy(cnew.begin() + first, cnew.begin() + last, c.begin() + first);
+                }
+            }
+
+            std::copy(h.begin(), h.end(), outputs[1].begin() + state_begin);
+            if(is_lstm)
+                std::copy(c.begin(), c.end(), outputs[2].begin() + state_begin);
+        }
+    };
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -34,10 +34,11 @@ inline namespace MIGRAPHX_INLINE_NS {
 struct module_pass_manager;
 
 /**
- * Runs several passes in a loop
+ * Runs several passes in a loop until the module stops changing or max_iterations is reached
  */
 struct MIGRAPHX_EXPORT optimize_module
 {
+    std::size_t max_iterations = 4;
     std::string name() const { return "optimize_module"; }
     void apply(module_pass_manager& mpm) const;
 };
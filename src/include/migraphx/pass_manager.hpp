@@ -28,6 +28,7 @@
 #include <migraphx/pass.hpp>
 #include <migraphx/module_ref.hpp>
 #include <migraphx/tracer.hpp>
+#include <migraphx/pass_stats.hpp>
 #include <vector>
 
 namespace migraphx {
@@ -51,11 +52,16 @@ struct module_pass_manager
 MIGRAPHX_EXPORT void run_passes(program& prog,
                                 module_ref root_mod,
                                 const std::vector<pass>& passes,
-                                tracer trace = tracer{});
-MIGRAPHX_EXPORT void
-run_passes(module& mod, const std::vector<pass>& passes, tracer trace = tracer{});
-MIGRAPHX_EXPORT void
-run_passes(program& prog, const std::vector<pass>& passes, tracer trace = tracer{});
+                                tracer trace      = tracer{},
+                                pass_stats* stats = nullptr);
+MIGRAPHX_EXPORT void run_passes(module& mod,
+                                const std::vector<pass>& passes,
+                                tracer trace      = tracer{},
+                                pass_stats* stats = nullptr);
+MIGRAPHX_EXPORT void run_passes(program& prog,
+                                const std::vector<pass>& passes,
+                                tracer trace      = tracer{},
+                                pass_stats* stats = nullptr);
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
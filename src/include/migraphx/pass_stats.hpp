@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_PASS_STATS_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_PASS_STATS_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Compile-time telemetry collected by run_passes. Every application of a pass to a module is
+ * aggregated by pass name, so passes that run several times or over many modules, including
+ * passes nested inside other passes, show up as a single entry.
+ */
+struct MIGRAPHX_EXPORT pass_stats
+{
+    /// `calls` counts every application of the pass to a module, `modules` the distinct modules
+    struct record
+    {
+        std::size_t calls                = 0;
+        std::size_t modules              = 0;
+        double total_ms                  = 0;
+        double max_ms                    = 0;
+        std::size_t instructions_before  = 0;
+        std::size_t instructions_after   = 0;
+        std::ptrdiff_t peak_rss_delta_kb = 0;
+    };
+
+    /// Record one application of a pass to a module
+    void add_module_pass(const std::string& name,
+                         const std::string& module_name,
+                         double ms,
+                         std::size_t instructions_before,
+                         std::size_t instructions_after,
+                         std::ptrdiff_t peak_rss_delta_kb);
+    /// Record the program-wide part of a pass that runs after it has been applied to each module
+    void add_program_pass(const std::string& name, double ms, std::ptrdiff_t peak_rss_delta_kb);
+
+    const record& get(const std::string& name) const;
+    bool contains(const std::string& name) const;
+
+    /// Pass names in the order they first ran
+    const std::vector<std::string>& names() const { return order; }
+
+    value to_value() const;
+    void print(std::ostream& os) const;
+
+    /// Peak resident set size of the process in KB, or 0 where it is not available
+    static std::size_t peak_rss_kb();
+
+    private:
+    record& get_record(const std::string& name);
+    std::vector<std::string> order;
+    std::unordered_map<std::string, record> records;
+    std::unordered_set<std::string> visited;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_PASS_STATS_HPP
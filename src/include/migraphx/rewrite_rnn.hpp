@@ -37,14 +37,19 @@ inline namespace MIGRAPHX_INLINE_NS {
 struct module;
 
 /**
- * Rewrite rnn to gemm and add.
+ * Rewrite rnn to gemm and add. When unroll is false, the rnn is replaced with a single
+ * rnn_sequence operator that loops over the timesteps instead.
  */
 struct MIGRAPHX_EXPORT rewrite_rnn
 {
+    bool unroll = true;
+
     std::string name() const { return "rewrite_rnn"; }
     void apply(module& m) const;
 
     private:
+    void replace_rnn_sequence(module& m, instruction_ref ins) const;
+
     // for vanilla rnn operators
     void apply_vanilla_rnn(module& m, instruction_ref ins) const;
     std::vector<instruction_ref> vanilla_rnn_cell(bool is_forward,
@@ -26,36 +26,234 @@
 
 #include <migraphx/shape.hpp>
 #include <migraphx/config.hpp>
+#include <migraphx/reduce_dims.hpp>
+#include <migraphx/simple_par_for.hpp>
 #include <algorithm>
+#include <functional>
+#include <numeric>
+#include <thread>
+#include <type_traits>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+/**
+ * A multi-index over a set of lens that is advanced by carrying into the next dimension instead
+ * of recomputing every dimension with a division. It also tracks the element offset of the index
+ * for each of the given strides, so several tensors can be walked at once.
+ */
+struct shape_odometer
+{
+    shape_odometer(std::vector<std::size_t> plens,
+                   const std::vector<std::vector<std::size_t>>& pstrides = {},
+                   std::size_t i                                       = 0)
+        : lens(std::move(plens)), idx(lens.size()), offsets(pstrides.size())
+    {
+        for(const auto& s : pstrides)
+        {
+            assert(s.size() == lens.size());
+            strides.insert(strides.end(), s.begin(), s.end());
+        }
+        seek(i);
+    }
+
+    const std::vector<std::size_t>& index() const { return idx; }
+
+    const std::vector<std::size_t>& offset() const { return offsets; }
+
+    std::size_t offset(std::size_t n) const { return offsets[n]; }
+
+    void seek(std::size_t i)
+    {
+        std::fill(idx.begin(), idx.end(), 0);
+        std::fill(offsets.begin(), offsets.end(), 0);
+        if(i == 0)
+            return;
+        for(std::size_t k = lens.size(); k > 0; k--)
+        {
+            auto j = k - 1;
+            idx[j] = i % lens[j];
+            i /= lens[j];
+            for(std::size_t n = 0; n < offsets.size(); n++)
+                offsets[n] += idx[j] * strides[n * lens.size() + j];
+        }
+    }
+
+    shape_odometer& operator++()
+    {
+        for(std::size_t k = lens.size(); k > 0; k--)
+        {
+            auto j = k - 1;
+            idx[j]++;
+            if(idx[j] < lens[j])
+            {
+                for(std::size_t n = 0; n < offsets.size(); n++)
+                    offsets[n] += strides[n * lens.size() + j];
+                return *this;
+            }
+            for(std::size_t n = 0; n < offsets.size(); n++)
+                offsets[n] -= (lens[j] - 1) * strides[n * lens.size() + j];
+            idx[j] = 0;
+        }
+        return *this;
+    }
+
+    private:
+    std::vector<std::size_t> lens;
+    std::vector<std::size_t> strides;
+    std::vector<std::size_t> idx;
+    std::vector<std::size_t> offsets;
+};
+
+namespace detail {
+
+template <class F>
+void shape_for_each_range(shape_odometer it, std::size_t start, std::size_t last, F& f)
+{
+    for(std::size_t i = start; i < last; i++, ++it)
+    {
+        if constexpr(std::is_invocable<F, const std::vector<std::size_t>&, std::size_t>{})
+            f(it.index(), i);
+        else
+            f(it.index());
+    }
+}
+
+template <class F>
+void shape_for_each_offset_range(shape_odometer it, std::size_t start, std::size_t last, F& f)
+{
+    for(std::size_t i = start; i < last; i++, ++it)
+        f(it.index(), it.offset());
+}
+
+// Split [0, n) into one contiguous chunk per thread, each at least min_grain long
+template <class F>
+void par_chunks(std::size_t n, std::size_t min_grain, F f)
+{
+    std::size_t nthreads =
+        std::min<std::size_t>(std::max<std::size_t>(1, std::thread::hardware_concurrency()),
+                              n / std::max<std::size_t>(1, min_grain));
+    if(nthreads <= 1)
+    {
+        f(std::size_t{0}, n);
+        return;
+    }
+    std::size_t grain = (n + nthreads - 1) / nthreads;
+    simple_par_for(nthreads, 1, [&](std::size_t t) {
+        auto start = t * grain;
+        auto last  = std::min(n, start + grain);
+        if(start < last)
+            f(start, last);
+    });
+}
+
+inline std::vector<std::vector<std::size_t>> strides_of(const std::vector<shape>& shapes)
+{
+    std::vector<std::vector<std::size_t>> result;
+    std::transform(shapes.begin(),
+                   shapes.end(),
+                   std::back_inserter(result),
+                   [](const shape& s) { return s.strides(); });
+    return result;
+}
+
+} // namespace detail
+
 /**
  * Iterates the given function over the indices from the shape in order.
  */
 template <class F>
 void shape_for_each(const migraphx::shape& s, F f)
 {
-    std::vector<std::size_t> indices(s.lens().size());
-    const auto& index_const_ref = indices;
-    shape ss{s.type(), s.lens()};
-    size_t max = ss.elements();
-    for(std::size_t i = 0; i < max; i++)
+    detail::shape_for_each_range(shape_odometer{s.lens()}, 0, s.elements(), f);
+}
+
+/**
+ * Same as shape_for_each, but the indices are split into contiguous chunks that are processed on
+ * separate threads, so the function must be safe to call concurrently.
+ */
+template <class F>
+void par_shape_for_each(const migraphx::shape& s, std::size_t min_grain, F f)
+{
+    detail::par_chunks(s.elements(), min_grain, [&](std::size_t start, std::size_t last) {
+        detail::shape_for_each_range(shape_odometer{s.lens(), {}, start}, start, last, f);
+    });
+}
+
+template <class F>
+void par_shape_for_each(const migraphx::shape& s, F f)
+{
+    const std::size_t min_grain = 4096;
+    par_shape_for_each(s, min_grain, f);
+}
+
+/**
+ * Iterates over the lens of the first shape and calls the function with the index and the element
+ * offset of that index into each of the shapes, which must have the same number of dimensions.
+ */
+template <class F>
+void shape_for_each_offset(const std::vector<shape>& shapes, F f)
+{
+    assert(not shapes.empty());
+    shape_odometer it{shapes.front().lens(), detail::strides_of(shapes)};
+    detail::shape_for_each_offset_range(it, 0, shapes.front().elements(), f);
+}
+
+template <class F>
+void par_shape_for_each_offset(const std::vector<shape>& shapes, std::size_t min_grain, F f)
+{
+    assert(not shapes.empty());
+    auto strides = detail::strides_of(shapes);
+    detail::par_chunks(
+        shapes.front().elements(), min_grain, [&](std::size_t start, std::size_t last) {
+            shape_odometer it{shapes.front().lens(), strides, start};
+            detail::shape_for_each_offset_range(it, start, last, f);
+        });
+}
+
+template <class F>
+void par_shape_for_each_offset(const std::vector<shape>& shapes, F f)
+{
+    const std::size_t min_grain = 4096;
+    par_shape_for_each_offset(shapes, min_grain, f);
+}
+
+/**
+ * Collapses the shapes with reduce_dims and calls the function once for each row of the innermost
+ * dimension. It passes the element offset of the row into each shape, the row length and the
+ * innermost stride of each shape, so the row can be processed with a simple strided loop. Rows are
+ * split into chunks that are processed on separate threads.
+ */
+template <class F>
+void par_shape_for_each_row(const std::vector<shape>& shapes, std::size_t min_grain, F f)
+{
+    assert(not shapes.empty());
+    auto rshapes     = reduce_dims(shapes);
+    const auto& lens = rshapes.front().lens();
+    std::size_t len  = lens.back();
+    std::vector<std::size_t> outer_lens(lens.begin(), lens.end() - 1);
+    std::vector<std::size_t> inner_strides;
+    std::vector<std::vector<std::size_t>> outer_strides;
+    for(const auto& s : rshapes)
     {
-        std::transform(ss.strides().begin(),
-                       ss.strides().end(),
-                       ss.lens().begin(),
-                       indices.begin(),
-                       [&](std::size_t stride, std::size_t len) {
-                           assert(len > 0 and stride > 0);
-                           return (i / stride) % len;
-                       });
-        if constexpr(std::is_invocable<F, decltype(index_const_ref), decltype(i)>{})
-            f(index_const_ref, i);
-        else
-            f(index_const_ref);
+        inner_strides.push_back(s.strides().back());
+        outer_strides.emplace_back(s.strides().begin(), s.strides().end() - 1);
     }
+    auto rows = std::accumulate(
+        outer_lens.begin(), outer_lens.end(), std::size_t{1}, std::multiplies<>{});
+    auto row_grain = std::max<std::size_t>(1, min_grain / std::max<std::size_t>(1, len));
+    detail::par_chunks(rows, row_grain, [&](std::size_t start, std::size_t last) {
+        shape_odometer it{outer_lens, outer_strides, start};
+        for(std::size_t i = start; i < last; i++, ++it)
+            f(it.offset(), len, inner_strides);
+    });
+}
+
+template <class F>
+void par_shape_for_each_row(const std::vector<shape>& shapes, F f)
+{
+    const std::size_t min_grain = 4096;
+    par_shape_for_each_row(shapes, min_grain, f);
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -166,7 +166,12 @@ bool operator==(const instruction& x, const instruction& y)
     if(std::tie(x.result, x.op, x.module_args) != std::tie(y.result, y.op, y.module_args))
         return false;
     if(x.name() == "@literal")
-        return x.lit == y.lit;
+    {
+        if(x.lit.shares_buffer(y.lit))
+            return true;
+        // Compare the cached hashes first to avoid comparing the contents of every literal
+        return x.lit.hash() == y.lit.hash() and x.lit == y.lit;
+    }
     return true;
 }
 
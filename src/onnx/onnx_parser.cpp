@@ -36,7 +36,10 @@
 #include <migraphx/op/unknown.hpp>
 #include <migraphx/float8.hpp>
 #include <migraphx/env.hpp>
+#include <migraphx/dynamic_par_for.hpp>
 #include <onnx.pb.h>
+#include <numeric>
+#include <unordered_set>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -320,18 +323,62 @@ void print_added_instructions(module* mod,
     mod->debug_print(added_instructions);
 }
 
+// Collect the names used by the nodes and outputs of the graph and all of its subgraphs
+static void get_used_names(const onnx::GraphProto& graph, std::unordered_set<std::string>& names)
+{
+    for(auto&& node : graph.node())
+    {
+        names.insert(node.input().begin(), node.input().end());
+        for(auto&& attr : node.attribute())
+        {
+            if(attr.has_g())
+                get_used_names(attr.g(), names);
+            for(auto&& g : attr.graphs())
+                get_used_names(g, names);
+        }
+    }
+    for(auto&& output : graph.output())
+        names.insert(output.name());
+}
+
 std::unordered_map<std::string, instruction_ref>
 parse_intializer(const onnx_parser& parser, module* mod, const onnx::GraphProto& graph)
 {
-    std::unordered_map<std::string, instruction_ref> mod_insts;
+    std::unordered_set<std::string> used;
+    get_used_names(graph, used);
+    // Initializers that are never used are not decoded
+    std::vector<const onnx::TensorProto*> tensors;
     for(auto&& f : graph.initializer())
     {
+        if(contains(used, f.name()))
+            tensors.push_back(&f);
+    }
+    // Decode the largest tensors first so the threads finish at about the same time
+    std::vector<std::size_t> order(tensors.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto elements = [&](std::size_t i) {
+        const auto& dims = tensors[i]->dims();
+        return std::accumulate(
+            dims.begin(), dims.end(), std::int64_t{1}, std::multiplies<std::int64_t>{});
+    };
+    std::stable_sort(order.begin(), order.end(), [&](auto x, auto y) {
+        return elements(x) > elements(y);
+    });
+    std::vector<literal> literals(tensors.size());
+    dynamic_par_for(order.size(), [&](auto i) {
+        literals[order[i]] = parser.parse_tensor(*tensors[order[i]]);
+    });
+
+    std::unordered_map<std::string, instruction_ref> mod_insts;
+    for(std::size_t i = 0; i < tensors.size(); i++)
+    {
+        const auto& name = tensors[i]->name();
         if(enabled(MIGRAPHX_TRACE_ONNX_PARSER{}))
-            std::cout << "initializer: " << f.name() << std::endl;
+            std::cout << "initializer: " << name << std::endl;
         // backup instructions in parent mod
-        mod_insts[f.name()] = mod->add_literal(parser.parse_tensor(f));
+        mod_insts[name] = mod->add_literal(std::move(literals[i]));
         if(enabled(MIGRAPHX_TRACE_ONNX_PARSER{}))
-            mod->debug_print(mod_insts[f.name()]);
+            mod->debug_print(mod_insts[name]);
     }
     return mod_insts;
 }
@@ -342,11 +389,16 @@ parse_inputs(const onnx_parser& parser,
              const onnx::GraphProto& graph,
              std::unordered_map<std::string, instruction_ref> mod_insts)
 {
+    std::unordered_set<std::string> initializers;
+    std::transform(graph.initializer().begin(),
+                   graph.initializer().end(),
+                   std::inserter(initializers, initializers.end()),
+                   [](auto&& f) { return f.name(); });
     for(auto&& input : graph.input())
     {
         const std::string& name = input.name();
         // input not in initializer_data, so it is a real input
-        if(not contains(mod_insts, name))
+        if(not contains(mod_insts, name) and not contains(initializers, name))
         {
             // ONNX specification does not specify how to deal with the
             // scenario that a nested subgraph contains a parameter with the
@@ -515,8 +567,7 @@ literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
             nbytes = std::stoul(t.external_data().at(2).value());
         }
         auto raw_buffer = read_buffer(path + "/" + data_file, offset, nbytes);
-        std::string s(raw_buffer.begin(), raw_buffer.end());
-        return create_literal(type, dims, s.data());
+        return create_literal(type, dims, raw_buffer.data());
     }
     if(t.has_raw_data())
     {
@@ -538,11 +589,10 @@ literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
     case onnx::TensorProto::UINT64:
         return create_literal(shape::uint64_type, dims, t.uint64_data());
     case onnx::TensorProto::FLOAT16: {
-        std::vector<uint16_t> data_uint16(t.int32_data().begin(), t.int32_data().end());
-        std::vector<half> data_half;
-        std::transform(data_uint16.begin(),
-                       data_uint16.end(),
-                       std::back_inserter(data_half),
+        std::vector<half> data_half(t.int32_data().size());
+        std::transform(t.int32_data().begin(),
+                       t.int32_data().end(),
+                       data_half.begin(),
                        [](uint16_t raw_val) { return *reinterpret_cast<half*>(&raw_val); });
         return create_literal(shape::half_type, dims, data_half);
     }
@@ -28,24 +28,67 @@
 #include <migraphx/eliminate_common_subexpression.hpp>
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/propagate_constant.hpp>
+#include <migraphx/module.hpp>
+#include <limits>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+namespace {
+
+// Tracks whether a pass can find anything more to do. A pass that ran without changing the
+// module will not change it again unless something else has changed the module since then.
+struct tracked_pass
+{
+    std::size_t unchanged_at = std::numeric_limits<std::size_t>::max();
+
+    template <class Pass>
+    bool run(module_pass_manager& mpm, const Pass& p)
+    {
+        auto before = mpm.get_module().get_change_count();
+        if(before == unchanged_at)
+            return false;
+        mpm.run_pass(p);
+        auto after = mpm.get_module().get_change_count();
+        if(after == before)
+        {
+            unchanged_at = after;
+            return false;
+        }
+        unchanged_at = std::numeric_limits<std::size_t>::max();
+        return true;
+    }
+};
+
+} // namespace
+
 void optimize_module::apply(module_pass_manager& mpm) const
 {
-    for(int i = 0; i < 2; i++)
+    tracked_pass reshapes;
+    tracked_pass algebra;
+    tracked_pass cse;
+    tracked_pass dce;
+    tracked_pass constants;
+    // Run until a fixed point is reached, the passes are skipped when nothing has changed
+    // since they last ran without changing the module
+    for(std::size_t i = 0; i < max_iterations; i++)
     {
+        bool changed = false;
         // loop to further optimize after initial transformations
-        for(int j = 0; j < 2; j++)
+        for(std::size_t j = 0; j < max_iterations; j++)
         {
-            mpm.run_pass(simplify_reshapes{});
-            mpm.run_pass(simplify_algebra{});
+            bool simplified = reshapes.run(mpm, simplify_reshapes{});
+            simplified      = algebra.run(mpm, simplify_algebra{}) or simplified;
+            if(not simplified)
+                break;
+            changed = true;
         }
-        mpm.run_pass(eliminate_common_subexpression{});
-        mpm.run_pass(dead_code_elimination{});
-        mpm.run_pass(propagate_constant{});
-        mpm.run_pass(dead_code_elimination{});
+        changed = cse.run(mpm, eliminate_common_subexpression{}) or changed;
+        changed = dce.run(mpm, dead_code_elimination{}) or changed;
+        changed = constants.run(mpm, propagate_constant{}) or changed;
+        changed = dce.run(mpm, dead_code_elimination{}) or changed;
+        if(not changed)
+            break;
     }
 }
 
@@ -58,10 +58,21 @@ void validate_pass(module& mod, const pass& p, tracer trace)
     trace();
 #endif
 }
-void run_pass(program& prog, const pass& p, tracer trace)
+using pass_milliseconds = std::chrono::duration<double, std::milli>;
+
+void run_pass(program& prog, const pass& p, tracer trace, pass_stats* stats)
 {
     trace("Pass: ", p.name());
-    p.apply(prog);
+    if(stats != nullptr)
+    {
+        auto rss = pass_stats::peak_rss_kb();
+        auto ms  = time<pass_milliseconds>([&] { p.apply(prog); });
+        stats->add_program_pass(p.name(), ms, pass_stats::peak_rss_kb() - rss);
+    }
+    else
+    {
+        p.apply(prog);
+    }
     trace(prog);
 }
 
@@ -72,6 +83,7 @@ struct module_pm : module_pass_manager
     tracer* t             = nullptr;
     module* common_parent = nullptr;
     program* prog         = nullptr;
+    pass_stats* stats     = nullptr;
 
     module_pm(module* pmod = nullptr, tracer* pt = nullptr) : mod(pmod), t(pt) {}
 
@@ -120,10 +132,20 @@ struct module_pm : module_pass_manager
         trace("Pass: ", p.name());
         assert(mod);
         assert(mod->validate() == mod->end());
-        if(enabled(MIGRAPHX_TIME_PASSES{}))
+        if(stats != nullptr)
+        {
+            auto before = mod->size();
+            auto rss    = pass_stats::peak_rss_kb();
+            auto ms     = time<pass_milliseconds>([&] { p.apply(*this); });
+            // Nested passes are recorded before the pass that runs them
+            stats->add_module_pass(
+                p.name(), mod->name(), ms, before, mod->size(), pass_stats::peak_rss_kb() - rss);
+            if(enabled(MIGRAPHX_TIME_PASSES{}))
+                std::cout << p.name() << ": " << ms << "ms\n";
+        }
+        else if(enabled(MIGRAPHX_TIME_PASSES{}))
         {
-            using milliseconds = std::chrono::duration<double, std::milli>;
-            auto ms            = time<milliseconds>([&] { p.apply(*this); });
+            auto ms = time<pass_milliseconds>([&] { p.apply(*this); });
             std::cout << p.name() << ": " << ms << "ms\n";
         }
         else
@@ -137,7 +159,11 @@ struct module_pm : module_pass_manager
 
 module& get_module(module_pass_manager& mpm) { return mpm.get_module(); }
 
-void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& passes, tracer trace)
+void run_passes(program& prog,
+                module_ref root_mod,
+                const std::vector<pass>& passes,
+                tracer trace,
+                pass_stats* stats)
 {
     if(enabled(MIGRAPHX_TRACE_PASSES{}))
         trace = tracer{std::cout};
@@ -156,6 +182,7 @@ void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& pas
                 continue;
             module_pm mpm{mod, root_mod, &trace};
             mpm.prog      = &prog;
+            mpm.stats     = stats;
             auto parents  = range(tree.equal_range(mod));
             auto nparents = distance(parents);
             if(nparents == 0)
@@ -168,23 +195,25 @@ void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& pas
                 mpm.common_parent = prog.get_main_module();
             mpm.run_pass(p);
         }
-        run_pass(prog, p, trace);
+        run_pass(prog, p, trace, stats);
     }
 }
 
-void run_passes(module& mod, const std::vector<pass>& passes, tracer trace)
+void run_passes(module& mod, const std::vector<pass>& passes, tracer trace, pass_stats* stats)
 {
     if(enabled(MIGRAPHX_TRACE_PASSES{}))
         trace = tracer{std::cout};
     for(const auto& p : passes)
     {
-        module_pm{&mod, &mod, &trace}.run_pass(p);
+        module_pm mpm{&mod, &mod, &trace};
+        mpm.stats = stats;
+        mpm.run_pass(p);
     }
 }
 
-void run_passes(program& prog, const std::vector<pass>& passes, tracer trace)
+void run_passes(program& prog, const std::vector<pass>& passes, tracer trace, pass_stats* stats)
 {
-    run_passes(prog, prog.get_main_module(), passes, trace);
+    run_passes(prog, prog.get_main_module(), passes, trace, stats);
 }
 
 } // namespace MIGRAPHX_INLINE_NS
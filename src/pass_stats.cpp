@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/pass_stats.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+pass_stats::record& pass_stats::get_record(const std::string& name)
+{
+    auto it = records.find(name);
+    if(it != records.end())
+        return it->second;
+    order.push_back(name);
+    return records[name];
+}
+
+void pass_stats::add_module_pass(const std::string& name,
+                                 const std::string& module_name,
+                                 double ms,
+                                 std::size_t instructions_before,
+                                 std::size_t instructions_after,
+                                 std::ptrdiff_t peak_rss_delta_kb)
+{
+    auto& r = get_record(name);
+    r.calls++;
+    if(visited.insert(name + ":" + module_name).second)
+        r.modules++;
+    r.total_ms += ms;
+    r.max_ms = std::max(r.max_ms, ms);
+    r.instructions_before += instructions_before;
+    r.instructions_after += instructions_after;
+    r.peak_rss_delta_kb += peak_rss_delta_kb;
+}
+
+void pass_stats::add_program_pass(const std::string& name,
+                                  double ms,
+                                  std::ptrdiff_t peak_rss_delta_kb)
+{
+    auto& r = get_record(name);
+    r.total_ms += ms;
+    r.max_ms = std::max(r.max_ms, ms);
+    r.peak_rss_delta_kb += peak_rss_delta_kb;
+}
+
+const pass_stats::record& pass_stats::get(const std::string& name) const
+{
+    auto it = records.find(name);
+    if(it == records.end())
+        MIGRAPHX_THROW("No stats for pass: " + name);
+    return it->second;
+}
+
+bool pass_stats::contains(const std::string& name) const { return migraphx::contains(records, name); }
+
+value pass_stats::to_value() const
+{
+    std::vector<value> passes;
+    std::transform(order.begin(), order.end(), std::back_inserter(passes), [&](const auto& name) {
+        const auto& r = records.at(name);
+        return value{{"name", name},
+                     {"calls", r.calls},
+                     {"modules", r.modules},
+                     {"total_ms", r.total_ms},
+                     {"max_ms", r.max_ms},
+                     {"instructions_before", r.instructions_before},
+                     {"instructions_after", r.instructions_after},
+                     {"peak_rss_delta_kb", r.peak_rss_delta_kb}};
+    });
+    return {{"passes", passes}};
+}
+
+void pass_stats::print(std::ostream& os) const
+{
+    std::vector<std::string> sorted = order;
+    std::stable_sort(sorted.begin(), sorted.end(), [&](const auto& x, const auto& y) {
+        return records.at(x).total_ms > records.at(y).total_ms;
+    });
+    os << std::left << std::setw(36) << "Pass" << std::right << std::setw(8) << "Calls"
+       << std::setw(12) << "Total ms" << std::setw(12) << "Max ms" << std::setw(14)
+       << "Ins before" << std::setw(14) << "Ins after" << std::setw(14) << "Peak RSS KB"
+       << std::endl;
+    for(const auto& name : sorted)
+    {
+        const auto& r = records.at(name);
+        os << std::left << std::setw(36) << name << std::right << std::setw(8) << r.calls
+           << std::setw(12) << r.total_ms << std::setw(12) << r.max_ms << std::setw(14)
+           << r.instructions_before << std::setw(14) << r.instructions_after << std::setw(14)
+           << r.peak_rss_delta_kb << std::endl;
+    }
+}
+
+std::size_t pass_stats::peak_rss_kb()
+{
+#ifdef _WIN32
+    return 0;
+#else
+    rusage usage{};
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    // ru_maxrss is in KB on Linux
+    return usage.ru_maxrss;
+#endif
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  */
 #include <migraphx/version.h>
+#include <migraphx/compile_cache.hpp>
 #include <migraphx/compile_options.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/stringutils.hpp>
@@ -282,7 +283,7 @@ void program::compile(const std::vector<target>& targets, std::vector<compile_op
             auto passes = root_target.get_passes(this->impl->contexts[root_target_id],
                                                  compile_opts[root_target_id]);
             passes.push_back(mark_instruction_target{static_cast<size_t>(root_target_id)});
-            run_passes(*this, current_mod, passes, trace);
+            run_passes(*this, current_mod, passes, trace, compile_opts[root_target_id].stats);
 
             auto invalid = current_mod->validate();
             if(invalid != current_mod->end())
@@ -307,6 +308,18 @@ void program::compile(const target& t, compile_options options)
 {
     // todo: combine with multi-target compile method
     assert(not this->is_compiled());
+    optional<compile_cache> cache;
+    std::string cache_key;
+    if(not options.cache_dir.empty())
+    {
+        cache.emplace(options.cache_dir, options.cache_max_bytes);
+        cache_key = compile_cache::key(*this, t, options);
+        if(auto cached = cache->load(cache_key))
+        {
+            *this = std::move(*cached);
+            return;
+        }
+    }
     this->impl->targets  = {t};
     this->impl->contexts = {t.get_context()};
 
@@ -316,7 +329,7 @@ void program::compile(const target& t, compile_options options)
     options.trace(*this);
     options.trace();
     auto&& passes = t.get_passes(this->impl->contexts.front(), options);
-    run_passes(*this, passes, options.trace);
+    run_passes(*this, passes, options.trace, options.stats);
     auto mods = this->get_modules();
     // Validate and finalize
     for(const auto& mod : reverse(mods))
@@ -336,6 +349,8 @@ void program::compile(const target& t, compile_options options)
         }
         mod->finalize(this->impl->contexts);
     }
+    if(cache.has_value())
+        cache->store(cache_key, *this);
 }
 
 void program::finalize()
@@ -622,7 +637,7 @@ std::string get_migraphx_version()
 program file version is for the data structure or format of the MXR file. Version should be bumped
 if any changes occur to the format of the MXR file.
 */
-const int program_file_version = 7;
+const int program_file_version = 8;
 
 value program::to_value() const
 {
@@ -633,6 +648,22 @@ value program::to_value() const
     result["contexts"]         = migraphx::to_value(this->impl->contexts);
     value module_vals          = value::object{};
     std::unordered_map<instruction_ref, std::string> names;
+    // Each unique literal is only stored once, and the nodes refer to it by its index
+    std::vector<literal> literals;
+    std::unordered_multimap<std::size_t, std::size_t> literal_ids;
+    auto get_literal_id = [&](const literal& l) {
+        auto h  = l.hash();
+        auto r  = range(literal_ids.equal_range(h));
+        auto it = std::find_if(r.begin(), r.end(), [&](const auto& pp) {
+            const auto& x = literals[pp.second];
+            return x.shares_buffer(l) or x == l;
+        });
+        if(it != r.end())
+            return it->second;
+        literals.push_back(l);
+        literal_ids.emplace(h, literals.size() - 1);
+        return literals.size() - 1;
+    };
     for(auto& mod : this->get_modules())
     {
         value mod_val;
@@ -646,7 +677,7 @@ value program::to_value() const
                 node["shape"]      = migraphx::to_value(ins->get_shape());
                 node["normalized"] = ins->is_normalized();
                 if(ins->name() == "@literal")
-                    node["literal"] = migraphx::to_value(ins->get_literal());
+                    node["literal"] = get_literal_id(ins->get_literal());
                 node["operator"] = ins->get_operator().to_value();
                 std::vector<std::string> inputs;
                 std::transform(ins->inputs().begin(),
@@ -678,13 +709,19 @@ value program::to_value() const
 
     result["modules"] = module_vals;
 
+    value literal_vals = value::array{};
+    for(const auto& l : literals)
+        literal_vals.push_back(migraphx::to_value(l));
+    result["literals"] = literal_vals;
+
     return result;
 }
 
 static void mod_from_val(module_ref mod,
                          const value& v,
                          std::unordered_map<std::string, instruction_ref>& instructions,
-                         const std::unordered_map<std::string, module_ref>& map_mods)
+                         const std::unordered_map<std::string, module_ref>& map_mods,
+                         const std::vector<literal>& literals)
 {
     const auto& module_val = v.at(mod->name());
     for(const value& node : module_val.at("nodes"))
@@ -702,8 +739,8 @@ static void mod_from_val(module_ref mod,
         }
         else if(name == "@literal")
         {
-            output =
-                mod->insert_literal(mod->end(), migraphx::from_value<literal>(node.at("literal")));
+            output = mod->insert_literal(mod->end(),
+                                         literals.at(node.at("literal").to<std::size_t>()));
         }
         else
         {
@@ -728,7 +765,7 @@ static void mod_from_val(module_ref mod,
 
                 for(const auto& smod : module_inputs)
                 {
-                    mod_from_val(smod, v, instructions, map_mods);
+                    mod_from_val(smod, v, instructions, map_mods, literals);
                 }
             }
 
@@ -792,9 +829,16 @@ void program::from_value(const value& v)
                    std::inserter(map_mods, map_mods.end()),
                    [&](auto&& pp) { return std::make_pair(pp.first, &pp.second); });
 
+    // Literals with the same contents share the same buffer
+    std::vector<literal> literals;
+    std::transform(v.at("literals").begin(),
+                   v.at("literals").end(),
+                   std::back_inserter(literals),
+                   [](const value& lv) { return migraphx::from_value<literal>(lv); });
+
     std::unordered_map<std::string, instruction_ref> map_insts;
     auto* mm = get_main_module();
-    mod_from_val(mm, module_vals, map_insts, map_mods);
+    mod_from_val(mm, module_vals, map_insts, map_mods, literals);
 
     // Finalize a compiled model
     if(not this->impl->contexts.empty())
@@ -0,0 +1,200 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/rewrite_resize.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/op/resize.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static std::vector<int>
+calc_neighbor_points(const std::vector<std::vector<std::vector<std::size_t>>>& vvv_ind,
+                     int i_dim,
+                     std::vector<std::vector<std::size_t>> vec_dims,
+                     const shape& in_s)
+{
+    if(i_dim == vvv_ind.size())
+    {
+        std::vector<int> vec_ind(vec_dims.size());
+        std::transform(vec_dims.begin(), vec_dims.end(), vec_ind.begin(), [&](auto idx) {
+            return static_cast<int>(in_s.index(idx));
+        });
+        return vec_ind;
+    }
+
+    const auto& vv_lo = vvv_ind[i_dim][0];
+    std::vector<std::vector<std::size_t>> vec_dims1;
+    for(std::size_t start = 0; start < vec_dims.size(); start += vv_lo.size())
+    {
+        std::transform(vv_lo.begin(),
+                       vv_lo.end(),
+                       vec_dims.begin() + start,
+                       std::back_inserter(vec_dims1),
+                       [](auto i, auto dim) {
+                           dim.push_back(i);
+                           return dim;
+                       });
+    }
+
+    const auto& vv_hi = vvv_ind[i_dim][1];
+    for(std::size_t start = 0; start < vec_dims.size(); start += vv_hi.size())
+    {
+        std::transform(vv_hi.begin(),
+                       vv_hi.end(),
+                       vec_dims.begin() + start,
+                       std::back_inserter(vec_dims1),
+                       [](auto i, auto dim) {
+                           dim.push_back(i);
+                           return dim;
+                       });
+    }
+    vec_dims.clear();
+    return calc_neighbor_points(vvv_ind, i_dim + 1, std::move(vec_dims1), in_s);
+}
+
+static instruction_ref rewrite_nearest(module& m, instruction_ref ins, const op::resize& op)
+{
+    auto in_s     = ins->inputs().front()->get_shape();
+    auto in_lens  = in_s.lens();
+    auto out_s    = ins->get_shape();
+    auto out_lens = out_s.lens();
+
+    std::vector<int64_t> rsp_lens = {static_cast<int64_t>(in_s.elements())};
+    auto rsp =
+        m.insert_instruction(ins, make_op("reshape", {{"dims", rsp_lens}}), ins->inputs().front());
+
+    // map out_idx to in_idx
+    std::vector<int> ind(out_s.elements());
+    shape_for_each(out_s, [&](const auto& out_idx_v, size_t out_idx) {
+        std::vector<size_t> in_idx(out_idx_v.size());
+        for(auto ii = 0; ii < in_lens.size(); ++ii)
+        {
+            auto idx_val = op.original_coordinate(in_lens[ii],
+                                                  out_lens[ii],
+                                                  out_idx_v[ii],
+                                                  op.get_scale(ii, in_lens[ii], out_lens[ii]));
+            in_idx[ii]   = op.nearest_index(in_lens[ii], idx_val);
+        }
+        ind[out_idx] = static_cast<int64_t>(in_s.index(in_idx));
+    });
+
+    shape ind_s{shape::int32_type, out_lens};
+    auto ins_ind = m.add_literal(literal(ind_s, ind));
+    return m.replace_instruction(ins, make_op("gather", {{"axis", 0}}), rsp, ins_ind);
+}
+
+static instruction_ref rewrite_linear(module& m, instruction_ref ins, const op::resize& op)
+{
+    auto in_s         = ins->inputs().front()->get_shape();
+    auto in_lens      = in_s.lens();
+    auto out_s        = ins->get_shape();
+    auto out_lens     = out_s.lens();
+    auto out_elements = out_s.elements();
+
+    std::vector<int64_t> rsp_lens = {static_cast<int64_t>(in_s.elements())};
+    auto rsp =
+        m.insert_instruction(ins, make_op("reshape", {{"dims", rsp_lens}}), ins->inputs().front());
+
+    // get the number of dimensions
+    std::size_t n_dim = out_lens.size();
+    std::vector<std::vector<std::size_t>> vv_ind(2, std::vector<std::size_t>(out_elements));
+    std::vector<std::vector<std::vector<std::size_t>>> vvv_ind(n_dim, vv_ind);
+    std::vector<std::vector<float>> delta(n_dim, std::vector<float>(out_elements));
+
+    shape_for_each(out_s, [&](const auto& out_idx_v, size_t out_idx) {
+        for(auto ii = 0; ii < in_lens.size(); ++ii)
+        {
+            auto idx_val = op.original_coordinate(in_lens[ii],
+                                                  out_lens[ii],
+                                                  out_idx_v[ii],
+                                                  op.get_scale(ii, in_lens[ii], out_lens[ii]));
+            auto clamped = std::max(0.0, std::min(in_lens[ii] - 1.0, idx_val));
+            vvv_ind[ii][0][out_idx] = std::floor(clamped);
+            vvv_ind[ii][1][out_idx] = std::ceil(clamped);
+            delta[ii][out_idx]      = idx_val - vvv_ind[ii][0][out_idx];
+        }
+    });
+
+    auto ind = calc_neighbor_points(
+        vvv_ind, 0, std::vector<std::vector<std::size_t>>(out_elements), in_s);
+    auto ind_lens = out_lens;
+    ind_lens[0] *= (std::size_t{1} << n_dim);
+    shape ind_s{shape::int32_type, ind_lens};
+    auto ins_ind = m.add_literal(literal(ind_s, ind));
+    auto data    = m.insert_instruction(ins, make_op("gather", {{"axis", 0}}), rsp, ins_ind);
+
+    auto dim_lens = out_lens;
+    dim_lens[0] *= (std::size_t{1} << (n_dim - 1));
+    for(std::size_t i = 0; i < n_dim; ++i)
+    {
+        shape dim_s{shape::float_type, dim_lens};
+        const auto& dim_delta = delta[n_dim - i - 1];
+        std::vector<float> delta_data;
+        for(std::size_t j = 0; j < dim_lens[0] / out_lens[0]; ++j)
+        {
+            delta_data.insert(delta_data.begin(), dim_delta.begin(), dim_delta.end());
+        }
+        auto ins_delta = m.add_literal(dim_s, delta_data);
+
+        // slice the data
+        int64_t slc_stride = dim_lens[0];
+        auto low           = m.insert_instruction(
+            ins,
+            make_op("slice", {{"axes", {0}}, {"starts", {0}}, {"ends", {slc_stride}}}),
+            data);
+        auto hi = m.insert_instruction(
+            ins,
+            make_op("slice",
+                    {{"axes", {0}}, {"starts", {slc_stride}}, {"ends", {2 * slc_stride}}}),
+            data);
+        auto diff = m.insert_instruction(ins, make_op("sub"), hi, low);
+        auto ddf  = m.insert_instruction(ins, make_op("mul"), diff, ins_delta);
+        data      = m.insert_instruction(ins, make_op("add"), ddf, low);
+        dim_lens[0] /= 2;
+    }
+    return m.replace_instruction(ins, data);
+}
+
+void rewrite_resize::apply(module& m) const
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "resize")
+            continue;
+        auto op = any_cast<op::resize>(ins->get_operator());
+        if(op.mode == "nearest")
+            rewrite_nearest(m, ins, op);
+        else if(op.mode == "linear")
+            rewrite_linear(m, ins, op);
+        else
+            MIGRAPHX_THROW("REWRITE_RESIZE: " + op.mode + " mode is not supported");
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -41,6 +41,7 @@
 #include <migraphx/op/common.hpp>
 #include <migraphx/op/rnn_var_sl_last_output.hpp>
 #include <migraphx/op/rnn_variable_seq_lens.hpp>
+#include <migraphx/op/rnn_sequence.hpp>
 #include <migraphx/make_op.hpp>
 
 #include <migraphx/iterator_for.hpp>
@@ -54,7 +55,11 @@ void rewrite_rnn::apply(module& m) const
 {
     for(auto ins : iterator_for(m))
     {
-        if(ins->name() == "rnn")
+        if(not unroll and contains({"rnn", "gru", "lstm"}, ins->name()))
+        {
+            replace_rnn_sequence(m, ins);
+        }
+        else if(ins->name() == "rnn")
         {
             apply_vanilla_rnn(m, ins);
         }
@@ -69,6 +74,41 @@ void rewrite_rnn::apply(module& m) const
     }
 }
 
+void rewrite_rnn::replace_rnn_sequence(module& m, instruction_ref ins) const
+{
+    // list the activation functions for every direction
+    operation rnn_op = ins->get_operator();
+    if(ins->name() == "rnn")
+    {
+        auto vanilla_op       = any_cast<op::rnn>(rnn_op);
+        vanilla_op.actv_funcs = vanilla_rnn_actv_funcs(ins);
+        rnn_op                = vanilla_op;
+    }
+    else if(ins->name() == "gru")
+    {
+        auto gru_op       = any_cast<op::gru>(rnn_op);
+        gru_op.actv_funcs = gru_actv_funcs(ins);
+        rnn_op            = gru_op;
+    }
+    else
+    {
+        auto lstm_op       = any_cast<op::lstm>(rnn_op);
+        lstm_op.actv_funcs = lstm_actv_funcs(ins);
+        rnn_op             = lstm_op;
+    }
+
+    auto seq = m.insert_instruction(ins, op::rnn_sequence{rnn_op}, ins->inputs());
+    auto outputs = ins->outputs();
+    for(auto output : outputs)
+    {
+        if(output->name() == "rnn_last_hs_output")
+            m.replace_instruction(output, make_op("get_tuple_elem", {{"index", 1}}), seq);
+        else if(output->name() == "rnn_last_cell_output")
+            m.replace_instruction(output, make_op("get_tuple_elem", {{"index", 2}}), seq);
+    }
+    m.replace_instruction(ins, make_op("get_tuple_elem", {{"index", 0}}), seq);
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 void rewrite_rnn::apply_vanilla_rnn(module& m, instruction_ref ins) const
 {
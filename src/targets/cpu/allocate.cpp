@@ -48,10 +48,9 @@ struct cpu_allocate : auto_register_op<cpu_allocate>
         check_shapes{inputs, *this}.has(0);
         return s;
     }
-    argument compute(context&, const shape& output_shape, const std::vector<argument>&) const
+    argument compute(context& ctx, const shape& output_shape, const std::vector<argument>&) const
     {
-        argument result{output_shape};
-        return result;
+        return {output_shape, ctx.get_host_buffer_pool().allocate(output_shape.bytes())};
     }
 };
 
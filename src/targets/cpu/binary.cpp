@@ -64,8 +64,8 @@ struct dnnl_binary : dnnl_op<dnnl_binary, dnnl::binary>
                 r = {s0.type(), s0.lens()};
             }
         }
-        // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        // Create the primitive to make sure an algo is available
+        this->get_cached_primitive(r, inputs);
         return r;
     }
 
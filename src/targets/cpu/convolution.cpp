@@ -38,6 +38,16 @@ namespace cpu {
 struct dnnl_convolution
     : dnnl_extend_op<dnnl_convolution, dnnl::convolution_forward, op::convolution>
 {
+    // Selected by tune_convolution
+    std::string algo = "convolution_auto";
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack_join(
+            self.reflect_base(self, f), migraphx::reflect(self.op, f), pack(f(self.algo, "algo")));
+    }
+
     std::vector<int> arg_map(int) const
     {
         return {MIGRAPHX_DNNL_PREFIX(ARG_SRC), MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)};
@@ -70,7 +80,7 @@ struct dnnl_convolution
         std::vector<size_t> padding_l(op.padding.begin(), op.padding.begin() + kdims);
         std::vector<size_t> padding_r(op.padding.begin() + kdims, op.padding.end());
         return {dnnl::prop_kind::forward_inference,
-                dnnl::algorithm::convolution_auto,
+                to_dnnl_algo(algo),
                 m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)),
                 m.at(MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)),
                 m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)),
@@ -80,6 +90,7 @@ struct dnnl_convolution
                 to_dnnl_dims(padding_r)};
     }
 };
+MIGRAPHX_REGISTER_OP(dnnl_pack_weights<dnnl_convolution>);
 
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
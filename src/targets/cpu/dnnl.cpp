@@ -22,6 +22,10 @@
  * THE SOFTWARE.
  */
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/ranges.hpp>
+#include <memory>
+#include <vector>
 
 #if defined(__GNUC__) && __GNUC__ <= 5
 namespace std {
@@ -47,6 +51,95 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DNNL_PRIMITIVE_CACHE_CAPACITY);
+
+dnnl_primitive_entry
+dnnl_primitive_cache::get(const std::string& key,
+                          const std::function<dnnl_primitive_entry()>& create)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = lookup.find(key);
+        if(it != lookup.end())
+        {
+            hit_count++;
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+        miss_count++;
+    }
+    // Create the primitive without holding the lock since it can be slow
+    auto result = create();
+    std::lock_guard<std::mutex> lock(mutex);
+    if(max_size == 0 or contains(lookup, key))
+        return result;
+    entries.emplace_front(key, result);
+    lookup[key] = entries.begin();
+    trim();
+    return result;
+}
+
+void dnnl_primitive_cache::trim()
+{
+    while(entries.size() > max_size)
+    {
+        lookup.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+std::size_t dnnl_primitive_cache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t dnnl_primitive_cache::capacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return max_size;
+}
+
+std::size_t dnnl_primitive_cache::hits() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hit_count;
+}
+
+std::size_t dnnl_primitive_cache::misses() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return miss_count;
+}
+
+void dnnl_primitive_cache::set_capacity(std::size_t n)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    max_size = n;
+    trim();
+}
+
+void dnnl_primitive_cache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lookup.clear();
+    hit_count  = 0;
+    miss_count = 0;
+}
+
+dnnl_context::dnnl_context()
+    : engine(dnnl::engine::kind::cpu, 0),
+      primitives(value_of(MIGRAPHX_DNNL_PRIMITIVE_CACHE_CAPACITY{}, 1024))
+{
+}
+
+dnnl::stream& dnnl_context::get_stream()
+{
+    thread_local dnnl::stream stream{engine};
+    return stream;
+}
+
 dnnl_context& get_dnnl_context()
 {
     static dnnl_context ctx{}; // NOLINT
@@ -105,6 +198,20 @@ dnnl::memory to_dnnl_memory(const argument& a)
     return to_dnnl_memory(to_dnnl_memory_desc(a.get_shape()), a);
 }
 
+dnnl::memory get_dnnl_scratchpad(const dnnl::memory::desc& desc)
+{
+    // Page align the scratchpad as dnnl does for the scratchpads it allocates itself
+    const std::size_t alignment = 4096;
+    thread_local std::vector<char> buffer;
+    auto n = desc.get_size() + alignment;
+    if(buffer.size() < n)
+        buffer.resize(n);
+    void* ptr   = buffer.data();
+    auto space  = buffer.size();
+    auto* start = std::align(alignment, desc.get_size(), ptr, space);
+    return {desc, get_dnnl_context().engine, start};
+}
+
 // clang-format off
 #define MIGRAPHX_VISIT_DNNL_ALGO(m) \
         m(undef) \
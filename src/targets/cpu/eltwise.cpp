@@ -53,8 +53,8 @@ struct dnnl_eltwise : dnnl_op<dnnl_eltwise, dnnl::eltwise_forward>
         auto r = s;
         if(not s.packed())
             r = shape{s.type(), s.lens()};
-        // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        // Create the primitive to make sure an algo is available
+        this->get_cached_primitive(r, inputs);
         return r;
     }
 
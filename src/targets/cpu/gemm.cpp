@@ -56,6 +56,7 @@ struct dnnl_gemm : dnnl_extend_op<dnnl_gemm, dnnl::matmul, op::dot>
                 m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST))};
     }
 };
+MIGRAPHX_REGISTER_OP(dnnl_pack_weights<dnnl_gemm>);
 
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
@@ -25,6 +25,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_CONTEXT_HPP
 
 #include <migraphx/config.hpp>
+#include <migraphx/host_buffer_pool.hpp>
 #include <migraphx/cpu/dnnl.hpp>
 #include <migraphx/cpu/parallel.hpp>
 #include <migraphx/par_for.hpp>
@@ -36,7 +37,13 @@ namespace cpu {
 
 struct context
 {
-    void finish() const {}
+    void finish() const { get_dnnl_context().get_stream().wait(); }
+
+    // Primitives are shared by all programs running on the cpu
+    dnnl_primitive_cache& get_primitive_cache() const { return get_dnnl_context().primitives; }
+
+    // Buffers released by one evaluation are reused by the next one
+    host_buffer_pool& get_host_buffer_pool() { return pool; }
 
     template <class F>
     void bulk_execute(std::size_t n, std::size_t min_grain, F f)
@@ -49,6 +56,9 @@ struct context
     {
         this->bulk_execute(n, 256, f);
     }
+
+    private:
+    host_buffer_pool pool;
 };
 
 } // namespace cpu
@@ -29,6 +29,12 @@
 #include <migraphx/reflect.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/check_shapes.hpp>
+#include <migraphx/rank.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/stringutils.hpp>
+#include <functional>
+#include <list>
+#include <mutex>
 #include <unordered_map>
 #include <migraphx/errors.hpp>
 #include <migraphx/assert.hpp>
@@ -50,11 +56,49 @@ namespace dnnl = zendnn;
 #endif
 #define MIGRAPHX_DNNL_PREFIX(b) MIGRAPHX_CONCAT_PREFIX(b) // NOLINT
 
+// A dnnl primitive together with the scratchpad it needs, the scratchpad is provided by the
+// caller so the same primitive can be executed concurrently from several threads
+struct dnnl_primitive_entry
+{
+    dnnl::primitive prim;
+    dnnl::memory::desc scratchpad;
+};
+
+// Process-wide LRU cache of dnnl primitives so identical instructions share a single primitive
+// across modules and programs
+struct dnnl_primitive_cache
+{
+    explicit dnnl_primitive_cache(std::size_t n) : max_size(n) {}
+
+    dnnl_primitive_entry get(const std::string& key,
+                             const std::function<dnnl_primitive_entry()>& create);
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    std::size_t hits() const;
+    std::size_t misses() const;
+    void set_capacity(std::size_t n);
+    void clear();
+
+    private:
+    void trim();
+
+    mutable std::mutex mutex;
+    std::size_t max_size;
+    std::size_t hit_count  = 0;
+    std::size_t miss_count = 0;
+    std::list<std::pair<std::string, dnnl_primitive_entry>> entries;
+    std::unordered_map<std::string, decltype(entries)::iterator> lookup;
+};
+
 struct dnnl_context
 {
     dnnl::engine engine;
-    dnnl::stream stream;
-    dnnl_context() : engine(dnnl::engine::kind::cpu, 0), stream(engine) {}
+    dnnl_primitive_cache primitives;
+    dnnl_context();
+
+    // Each thread executes on its own stream
+    dnnl::stream& get_stream();
 };
 
 dnnl_context& get_dnnl_context();
@@ -75,6 +119,9 @@ dnnl::memory to_dnnl_memory(const dnnl::memory::desc& desc, const argument& a);
 
 dnnl::memory to_dnnl_memory(const argument& a);
 
+// Scratchpad memory local to the calling thread
+dnnl::memory get_dnnl_scratchpad(const dnnl::memory::desc& desc);
+
 dnnl::algorithm to_dnnl_algo(const std::string& name);
 
 std::string to_string(const dnnl::algorithm& algo);
@@ -108,14 +155,19 @@ template <class Derived, class Primitive>
 struct dnnl_op : auto_register_op<Derived>
 {
     std::vector<post_op> post_ops;
+    // Shape of the weights when they were reordered at compile time into the layout preferred by
+    // dnnl, the weights argument is then an opaque buffer
+    shape packed_weights = {};
     std::function<argument(context& ctx, const std::vector<argument>& args)> execute;
 
     template <class Self, class F>
     static auto reflect_base(Self& self, F f)
     {
-        return pack(f(self.post_ops, "post_ops"));
+        return pack(f(self.post_ops, "post_ops"), f(self.packed_weights, "packed_weights"));
     }
 
+    bool has_packed_weights() const { return not packed_weights.lens().empty(); }
+
     template <class Self, class F>
     static auto reflect(Self& self, F f)
     {
@@ -162,7 +214,7 @@ struct dnnl_op : auto_register_op<Derived>
         });
         return shapes;
     }
-    static std::string impl(const Primitive& prim)
+    static std::string impl(const dnnl::primitive& prim)
     {
         auto desc       = prim.get_primitive_desc();
         const char* str = nullptr;
@@ -235,6 +287,43 @@ struct dnnl_op : auto_register_op<Derived>
         });
         return m;
     }
+    // Index of the weights in the inputs
+    int weights_index(std::size_t input_size) const
+    {
+        auto m = create_arg_map(input_size);
+        return std::find(m.begin(), m.end(), MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)) - m.begin();
+    }
+    // Replace the packed weights buffer with the shape of the weights
+    std::vector<shape> unpack_shapes(std::vector<shape> inputs) const
+    {
+        if(has_packed_weights())
+            inputs.at(weights_index(inputs.size())) = packed_weights;
+        return inputs;
+    }
+    template <class PrimitiveDesc>
+    static auto get_weights_desc(const PrimitiveDesc& pd, rank<1>) -> decltype(pd.weights_desc())
+    {
+        return pd.weights_desc();
+    }
+    template <class PrimitiveDesc>
+    static dnnl::memory::desc get_weights_desc(const PrimitiveDesc&, rank<0>)
+    {
+        MIGRAPHX_THROW("Primitive does not have weights");
+    }
+    // Let dnnl choose the layout of the weights
+    dnnl::memory::desc get_packed_weights_desc(std::unordered_map<int, dnnl::memory::desc> m,
+                                               const shape& output_shape,
+                                               std::size_t input_size) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        auto ws = self.adjust_shape(packed_weights, weights_index(input_size), output_shape);
+        m[MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)] = {to_dnnl_dims(ws.lens()),
+                                                to_dnnl_memory_data_type(ws.type()),
+                                                dnnl::memory::format_tag::any};
+        auto desc = self.get_desc(m);
+        auto attr = MIGRAPHX_ASSERT_NO_THROW(this->get_primitive_attr(m));
+        return get_weights_desc(self.get_primitive_desc(desc, attr), rank<1>{});
+    }
     std::unordered_map<int, dnnl::memory::desc>
     to_memory_desc(const shape& output_shape, const std::vector<shape>& inputs) const
     {
@@ -246,14 +335,20 @@ struct dnnl_op : auto_register_op<Derived>
         assert(m.size() >= inputs.size());
         for(int i = 0; i < inputs.size(); i++)
         {
+            if(has_packed_weights() and m[i] == MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS))
+                continue;
             result[m[i]] = to_dnnl_memory_desc(self.adjust_shape(inputs[i], i, output_shape));
         }
+        if(has_packed_weights())
+            result[MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)] =
+                get_packed_weights_desc(result, output_shape, inputs.size());
         return result;
     }
     dnnl::primitive_attr
     get_primitive_attr(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
         dnnl::primitive_attr result;
+        result.set_scratchpad_mode(dnnl::scratchpad_mode::user);
         dnnl::post_ops po;
         for_each_post_op([&](auto&& op, auto arg) {
             if(contains(op.algo, "binary_add"))
@@ -282,13 +377,20 @@ struct dnnl_op : auto_register_op<Derived>
     {
         return typename Primitive::primitive_desc(desc, attr, get_dnnl_context().engine);
     }
-    Primitive get_primitive(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    dnnl_primitive_entry get_cached_primitive(const shape& output_shape,
+                                              const std::vector<shape>& inputs) const
     {
         const auto& self = static_cast<const Derived&>(*this);
-        auto desc        = self.get_desc(m);
-        auto attr        = MIGRAPHX_ASSERT_NO_THROW(this->get_primitive_attr(m));
-        auto pd          = self.get_primitive_desc(desc, attr);
-        return Primitive(pd);
+        auto key         = self.name() + to_string(migraphx::to_value(self)) +
+                   to_string(migraphx::to_value(output_shape)) +
+                   to_string(migraphx::to_value(inputs));
+        return get_dnnl_context().primitives.get(key, [&]() -> dnnl_primitive_entry {
+            auto m    = this->to_memory_desc(output_shape, inputs);
+            auto desc = self.get_desc(m);
+            auto attr = MIGRAPHX_ASSERT_NO_THROW(this->get_primitive_attr(m));
+            auto pd   = self.get_primitive_desc(desc, attr);
+            return {Primitive(pd), pd.scratchpad_desc()};
+        });
     }
     argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
@@ -303,9 +405,7 @@ struct dnnl_op : auto_register_op<Derived>
     {
         // Compensate for allocation
         inputs.pop_back();
-        auto md        = to_memory_desc(output_shape, inputs);
-        auto prim      = get_primitive(md);
-        auto impl_name = impl(prim);
+        auto impl_name = impl(get_cached_primitive(output_shape, inputs).prim);
         return {{"impl", impl_name}};
     }
 
@@ -316,7 +416,7 @@ struct dnnl_op : auto_register_op<Derived>
         const auto& self = static_cast<const Derived&>(*this);
         auto name        = self.name();
         auto md          = to_memory_desc(output_shape, inputs);
-        auto prim        = get_primitive(md);
+        auto entry       = get_cached_primitive(output_shape, inputs);
         auto arg_lookup  = create_arg_map(inputs.size());
 #ifndef NDEBUG
         auto prim_attr = get_primitive_attr(md);
@@ -390,7 +490,9 @@ struct dnnl_op : auto_register_op<Derived>
                 to_dnnl_memory(md.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)), args.back());
             for(int i = 0; i < args.size() - 1; i++)
                 m[arg_lookup[i]] = to_dnnl_memory(md.at(arg_lookup[i]), args[i]);
-            prim.execute(get_dnnl_context().stream, m);
+            if(entry.scratchpad.get_size() > 0)
+                m[MIGRAPHX_DNNL_PREFIX(ARG_SCRATCHPAD)] = get_dnnl_scratchpad(entry.scratchpad);
+            entry.prim.execute(get_dnnl_context().get_stream(), m);
             return args.back();
         });
     }
@@ -425,14 +527,60 @@ struct dnnl_extend_op : dnnl_op<Derived, Primitive>
         const auto& self = static_cast<const Derived&>(*this);
         // Compensate for allocation
         inputs.pop_back();
-        self.required(check_shapes(inputs, self));
-        auto r = migraphx::compute_shape(op, this->trim_post_op_inputs(inputs));
-        // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        auto unpacked = this->unpack_shapes(inputs);
+        self.required(check_shapes(unpacked, self));
+        auto r = migraphx::compute_shape(op, this->trim_post_op_inputs(unpacked));
+        // Create the primitive to make sure an algo is available
+        this->get_cached_primitive(r, inputs);
         return r;
     }
 };
 
+// Reorders constant weights into the layout preferred by a dnnl primitive
+template <class Op>
+struct dnnl_pack_weights : auto_register_op<dnnl_pack_weights<Op>>
+{
+    Op op;
+    shape output;
+    // Inputs of op without the allocation
+    std::vector<shape> inputs;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.op, "op"), f(self.output, "output"), f(self.inputs, "inputs"));
+    }
+
+    std::string name() const { return Op{}.name() + "::pack_weights"; }
+
+    dnnl::memory::desc get_packed_desc() const
+    {
+        return op.to_memory_desc(output, inputs).at(MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS));
+    }
+
+    shape compute_shape(const std::vector<shape>& args) const
+    {
+        check_shapes{args, *this}.has(1);
+        if(not op.has_packed_weights())
+            MIGRAPHX_THROW(name() + ": packed_weights is not set");
+        return {shape::uint8_type, {get_packed_desc().get_size()}};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        auto& ctx       = get_dnnl_context();
+        auto plain_desc = to_dnnl_memory_desc(op.adjust_shape(
+            op.packed_weights, op.weights_index(inputs.size()), output));
+        argument result{output_shape};
+        dnnl::memory src{plain_desc, ctx.engine, args.front().data()};
+        dnnl::memory dst{get_packed_desc(), ctx.engine, result.data()};
+        auto& stream = ctx.get_stream();
+        dnnl::reorder(src, dst).execute(stream, src, dst);
+        stream.wait();
+        return result;
+    }
+};
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
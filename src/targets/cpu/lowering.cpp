@@ -45,6 +45,7 @@
 #include <migraphx/op/mod.hpp>
 #include <migraphx/op/fmod.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/copy_layout.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/par_dfor.hpp>
 #include <migraphx/clamp.hpp>
@@ -95,8 +96,9 @@ struct cpu_im2col
         return op.normalize_compute_shape(inputs);
     }
 
-    argument compute(context&, const shape& output_shape, std::vector<argument> args) const
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         argument result{output_shape};
         auto input_shape   = args[0].get_shape();
         auto weights_shape = args[1].get_shape();
@@ -155,8 +157,10 @@ struct cpu_op
     }
     std::string name() const { return "cpu::op"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
-    argument compute(context&, const shape& output_shape, const std::vector<argument>& args) const
+    argument
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         return op.compute(output_shape, args);
     }
     value to_value() const
@@ -190,8 +194,9 @@ struct cpu_pad
 
     std::string name() const { return "cpu::pad"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
-    argument compute(context&, const shape& output_shape, std::vector<argument> args) const
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         assert(output_shape.standard());
         argument result{output_shape};
         result.visit([&](auto output) {
@@ -199,16 +204,14 @@ struct cpu_pad
             std::fill(output.begin(), output.end(), pad_clamp<type>(op.value));
         });
 
-        visit_all(result, args[0])([&](auto output, auto input) {
-            shape_for_each(input.get_shape(), [&](const auto& idx) {
-                std::vector<std::size_t> new_idx(idx.size());
-                std::transform(
-                    idx.begin(), idx.end(), op.pads.begin(), new_idx.begin(), [](auto i, auto j) {
-                        return i + j;
-                    });
-                output(new_idx.begin(), new_idx.end()) = input(idx.begin(), idx.end());
-            });
-        });
+        const auto& input_shape = args[0].get_shape();
+        std::vector<std::size_t> starts(op.pads.begin(),
+                                        op.pads.begin() + input_shape.lens().size());
+        auto slice_shape = shape{input_shape.type(), input_shape.lens(), output_shape.strides()};
+        copy_layout(input_shape,
+                    args[0].data(),
+                    slice_shape,
+                    result.data() + output_shape.index(starts) * slice_shape.type_size());
 
         return result;
     }
@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/pack_weights.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/env.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_DNNL_PACK_WEIGHTS);
+
+void pack_weights::apply(module& m) const
+{
+    if(enabled(MIGRAPHX_DISABLE_DNNL_PACK_WEIGHTS{}))
+        return;
+    for(auto ins : iterator_for(m))
+    {
+        if(not contains({"dnnl::convolution", "dnnl::dot"}, ins->name()))
+            continue;
+        auto w = ins->inputs().at(1);
+        if(w->name() != "@literal")
+            continue;
+        auto v = ins->get_operator().to_value();
+        if(not from_value<shape>(v.at("packed_weights")).lens().empty())
+            continue;
+        v["packed_weights"] = to_value(w->get_shape());
+        auto inputs         = to_shapes(ins->inputs());
+        // Skip the allocation
+        inputs.pop_back();
+        auto pack         = make_op(ins->name() + "::pack_weights",
+                            {{"op", v},
+                             {"output", to_value(ins->get_shape())},
+                             {"inputs", to_value(inputs)}});
+        auto packed_shape = try_compute_shape(pack, {w->get_shape()});
+        // There is no dnnl primitive that can use these weights in a packed layout
+        if(packed_shape.empty())
+            continue;
+        auto packed = pack.compute(packed_shape.front(), {w->get_literal().get_argument()});
+        auto new_w  = m.add_literal(literal{packed_shape.front(), packed.data()});
+        auto args   = ins->inputs();
+        args.at(1)  = new_w;
+        m.replace_instruction(ins, make_op(ins->name(), v), args);
+    }
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
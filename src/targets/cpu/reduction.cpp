@@ -53,8 +53,8 @@ struct dnnl_reduction : dnnl_op<dnnl_reduction, dnnl::reduction>
             lens[axis] = 1;
         }
         auto r = shape{s.type(), lens};
-        // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        // Create the primitive to make sure an algo is available
+        this->get_cached_primitive(r, inputs);
         return r;
     }
 
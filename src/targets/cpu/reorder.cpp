@@ -38,8 +38,8 @@ struct dnnl_reorder : dnnl_op<dnnl_reorder, dnnl::reorder>
     {
         check_shapes{inputs, *this}.has(2);
         auto r = inputs.back();
-        // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        // Create the primitive to make sure an algo is available
+        this->get_cached_primitive(r, inputs);
         return r;
     }
     // Custom desc class since its missing in dnnl
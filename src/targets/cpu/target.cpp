@@ -30,8 +30,10 @@
 #include <migraphx/eliminate_concat.hpp>
 #include <migraphx/eliminate_contiguous.hpp>
 #include <migraphx/eliminate_data_type.hpp>
+#include <migraphx/eliminate_duplicate_literals.hpp>
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
+#include <migraphx/env.hpp>
 #include <migraphx/layout_nhwc.hpp>
 #include <migraphx/memory_coloring.hpp>
 #include <migraphx/propagate_constant.hpp>
@@ -46,6 +48,8 @@
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/preallocate_param.hpp>
 #include <migraphx/cpu/fuse_ops.hpp>
+#include <migraphx/cpu/pack_weights.hpp>
+#include <migraphx/cpu/tune_convolution.hpp>
 #include <migraphx/cpu/write_literals.hpp>
 #include <migraphx/cpu/allocation_model.hpp>
 #include <migraphx/cpu/target.hpp>
@@ -59,10 +63,12 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_UNROLL_RNN)
+
 std::string target::name() const { return "cpu"; }
 
 // cppcheck-suppress constParameterReference
-std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options&) const
+std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options& options) const
 {
     auto& ctx = any_cast<context>(gctx);
     std::set<shape::type_t> unsupported_types(shape::types().begin(), shape::types().end());
@@ -76,7 +82,7 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             eliminate_identity{},
             eliminate_pad{},
             dead_code_elimination{},
-            rewrite_rnn{},
+            rewrite_rnn{enabled(MIGRAPHX_UNROLL_RNN{})},
             dead_code_elimination{},
             eliminate_common_subexpression{},
             dead_code_elimination{},
@@ -89,6 +95,7 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             simplify_reshapes{},
             propagate_constant{},
             dead_code_elimination{},
+            eliminate_duplicate_literals{},
             lowering{},
             eliminate_contiguous{"dnnl::reorder"},
             dead_code_elimination{},
@@ -98,6 +105,10 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             fuse_ops{&ctx},
             dead_code_elimination{},
+            tune_convolution{&ctx, options.exhaustive_tune},
+            dead_code_elimination{},
+            pack_weights{},
+            dead_code_elimination{},
             write_literals{},
             dead_code_elimination{},
             memory_coloring{"cpu::allocate"},
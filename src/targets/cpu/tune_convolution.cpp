@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/tune_convolution.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/sqlite.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/time.hpp>
+#include <migraphx/env.hpp>
+#include <iostream>
+#include <limits>
+#include <mutex>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_TUNING_DB);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_BENCHMARKING);
+
+namespace {
+
+fs::path get_tuning_db_path()
+{
+    auto p = string_value_of(MIGRAPHX_CPU_TUNING_DB{});
+    if(not p.empty())
+        return p;
+    return fs::temp_directory_path() / "migraphx" / "cpu_tuning.db";
+}
+
+std::string quote(const std::string& s) { return "'" + replace_string(s, "'", "''") + "'"; }
+
+struct tuning_db
+{
+    fs::path path = get_tuning_db_path();
+
+    optional<std::string> get(const std::string& problem) const
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        if(not fs::exists(path))
+            return nullopt;
+        auto db   = sqlite::read(path);
+        auto rows = db.execute("SELECT name FROM sqlite_master WHERE type='table' AND "
+                               "name='convolution'");
+        if(rows.empty())
+            return nullopt;
+        rows = db.execute("SELECT algo FROM convolution WHERE problem = " + quote(problem));
+        if(rows.empty())
+            return nullopt;
+        return rows.front().at("algo");
+    }
+
+    void insert(const std::string& problem, const std::string& algo, double t) const
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        if(path.has_parent_path())
+            fs::create_directories(path.parent_path());
+        auto db = sqlite::write(path);
+        db.execute("CREATE TABLE IF NOT EXISTS convolution "
+                   "(problem TEXT PRIMARY KEY, algo TEXT NOT NULL, time REAL)");
+        db.execute("INSERT OR REPLACE INTO convolution VALUES (" + quote(problem) + ", " +
+                   quote(algo) + ", " + std::to_string(t) + ")");
+    }
+
+    static std::mutex& mutex()
+    {
+        static std::mutex m; // NOLINT
+        return m;
+    }
+};
+
+// Average time in milliseconds of running the operator
+double time_op(context& ctx, operation op, const shape& output, const std::vector<shape>& inputs)
+{
+    const std::size_t n = 20;
+    migraphx::context gctx{ctx};
+    std::vector<argument> args(inputs.size());
+    std::transform(inputs.begin(), inputs.end(), args.begin(), [](const shape& s) {
+        return generate_argument(s);
+    });
+    op.finalize(gctx, output, inputs);
+    // Warmup
+    op.compute(gctx, output, args);
+    auto t = time<std::chrono::duration<double, std::milli>>([&] {
+        for(std::size_t i = 0; i < n; i++)
+            op.compute(gctx, output, args);
+        gctx.finish();
+    });
+    return t / n;
+}
+
+optional<std::string>
+benchmark(context& ctx, instruction_ref ins, const value& v, const std::string& problem)
+{
+    const auto trace_level = value_of(MIGRAPHX_TRACE_BENCHMARKING{});
+    const std::vector<std::string> algos = {
+        "convolution_auto", "convolution_direct", "convolution_winograd"};
+    auto inputs = to_shapes(ins->inputs());
+    std::vector<double> times;
+    for(const auto& algo : algos)
+    {
+        auto sv    = v;
+        sv["algo"] = algo;
+        auto op    = make_op(ins->name(), sv);
+        // dnnl throws when it has no implementation of the algorithm for this problem
+        if(try_compute_shape(op, inputs).empty())
+        {
+            if(trace_level > 1)
+                std::cout << "No implementation: " << algo << std::endl;
+            times.push_back(std::numeric_limits<double>::max());
+            continue;
+        }
+        times.push_back(time_op(ctx, op, ins->get_shape(), inputs));
+        if(trace_level > 1)
+            std::cout << algo << ": " << times.back() << "ms" << std::endl;
+    }
+    auto i = std::distance(times.begin(), std::min_element(times.begin(), times.end()));
+    if(times[i] == std::numeric_limits<double>::max())
+        return nullopt;
+    if(trace_level > 0)
+        std::cout << "Fastest solution: " << algos[i] << std::endl;
+    tuning_db{}.insert(problem, algos[i], times[i]);
+    return algos[i];
+}
+
+} // namespace
+
+void tune_convolution::apply(module& m) const
+{
+    const auto trace_level = value_of(MIGRAPHX_TRACE_BENCHMARKING{});
+    tuning_db db;
+    // Problems already solved in this module
+    std::unordered_map<std::string, optional<std::string>> solved;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "dnnl::convolution")
+            continue;
+        auto v = ins->get_operator().to_value();
+        // The problem does not depend on the algorithm
+        v["algo"]   = "";
+        auto inputs = to_shapes(ins->inputs());
+        auto problem = to_json_string(
+            {{"op", v}, {"inputs", to_value(inputs)}, {"output", to_value(ins->get_shape())}});
+        if(not contains(solved, problem))
+        {
+            auto algo = db.get(problem);
+            if(not algo.has_value() and exhaustive)
+            {
+                if(trace_level > 0)
+                    std::cout << "Benchmarking dnnl::convolution: " << problem << std::endl;
+                algo = benchmark(*ctx, ins, v, problem);
+            }
+            solved[problem] = algo;
+        }
+        auto algo = solved.at(problem);
+        if(not algo.has_value())
+            continue;
+        v["algo"] = *algo;
+        m.replace_instruction(ins, make_op(ins->name(), v), ins->inputs());
+    }
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -25,6 +25,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_CONTEXT_HPP
 
 #include <migraphx/config.hpp>
+#include <migraphx/host_buffer_pool.hpp>
 #include <migraphx/ref/export.h>
 
 namespace migraphx {
@@ -34,6 +35,12 @@ namespace ref {
 struct context
 {
     void finish() const {}
+
+    /// Pool the outputs of the reference kernels are allocated from
+    host_buffer_pool& get_host_buffer_pool() { return pool; }
+
+    private:
+    host_buffer_pool pool;
 };
 
 } // namespace ref
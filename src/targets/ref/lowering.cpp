@@ -41,6 +41,8 @@
 #include <migraphx/op/argmin.hpp>
 #include <migraphx/op/rnn_var_sl_last_output.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/copy_layout.hpp>
+#include <migraphx/host_buffer_pool.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/par_dfor.hpp>
 #include <migraphx/clamp.hpp>
@@ -83,8 +85,9 @@ struct ref_lrn
 
     std::string name() const { return "ref::lrn"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
-    argument compute(context&, shape output_shape, std::vector<argument> args) const
+    argument compute(context& ctx, shape output_shape, std::vector<argument> args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         argument result{output_shape};
         visit_all(result, args[0])([&](auto output, auto input) {
             int n_batch         = output_shape.lens()[0];
@@ -147,8 +150,9 @@ struct ref_im2col
         return op.normalize_compute_shape(inputs);
     }
 
-    argument compute(context&, const shape& output_shape, std::vector<argument> args) const
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         argument result{output_shape};
         auto input_shape   = args[0].get_shape();
         auto weights_shape = args[1].get_shape();
@@ -207,8 +211,10 @@ struct ref_op
     }
     std::string name() const { return "ref::op"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
-    argument compute(context&, const shape& output_shape, const std::vector<argument>& args) const
+    argument
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         return op.compute(output_shape, args);
     }
     value to_value() const
@@ -242,8 +248,9 @@ struct ref_pad
 
     std::string name() const { return "ref::pad"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
-    argument compute(context&, const dyn_output& dyn_out, std::vector<argument> args) const
+    argument compute(context& ctx, const dyn_output& dyn_out, std::vector<argument> args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         assert(dyn_out.computed_shape.standard());
         argument result{dyn_out.computed_shape};
         result.visit([&](auto output) {
@@ -251,16 +258,15 @@ struct ref_pad
             std::fill(output.begin(), output.end(), pad_clamp<type>(op.value));
         });
 
-        visit_all(result, args[0])([&](auto output, auto input) {
-            shape_for_each(input.get_shape(), [&](const auto& idx) {
-                std::vector<std::size_t> new_idx(idx.size());
-                std::transform(
-                    idx.begin(), idx.end(), op.pads.begin(), new_idx.begin(), [](auto i, auto j) {
-                        return i + j;
-                    });
-                output(new_idx.begin(), new_idx.end()) = input(idx.begin(), idx.end());
-            });
-        });
+        const auto& input_shape  = args[0].get_shape();
+        const auto& output_shape = dyn_out.computed_shape;
+        std::vector<std::size_t> starts(op.pads.begin(),
+                                        op.pads.begin() + input_shape.lens().size());
+        auto slice_shape = shape{input_shape.type(), input_shape.lens(), output_shape.strides()};
+        copy_layout(input_shape,
+                    args[0].data(),
+                    slice_shape,
+                    result.data() + output_shape.index(starts) * slice_shape.type_size());
 
         return result;
     }
@@ -279,8 +285,9 @@ struct ref_gemm
     std::string name() const { return "ref::dot"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
 
-    argument compute(context&, const dyn_output& dyn_out, std::vector<argument> args) const
+    argument compute(context& ctx, const dyn_output& dyn_out, std::vector<argument> args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         argument result{dyn_out.computed_shape};
         visit_all(result, args[0], args[1])(
             [&](auto cmat, auto amat, auto bmat) { gemm(cmat, amat, bmat, 1.0f, 0.0f); });
@@ -302,8 +309,9 @@ struct ref_quant_gemm
     std::string name() const { return "ref::quant_dot"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
 
-    argument compute(context&, const shape& output_shape, std::vector<argument> args) const
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         argument result{output_shape};
         result.visit([&](auto cmat) {
             visit_all(args.at(0), args.at(1))(
@@ -335,8 +343,9 @@ struct ref_softmax : auto_register_op<ref_softmax<Op>>
     {
         return op.normalize_compute_shape(inputs);
     }
-    argument compute(context&, const dyn_output& dyn_out, std::vector<argument> args) const
+    argument compute(context& ctx, const dyn_output& dyn_out, std::vector<argument> args) const
     {
+        scoped_host_buffer_pool pool{ctx.get_host_buffer_pool()};
         argument result{dyn_out.computed_shape};
         auto batch_lens        = dyn_out.computed_shape.lens();
         int64_t tuned_axis     = tune_axis(args[0].get_shape().lens().size(), op.axis, op.name());
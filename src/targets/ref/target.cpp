@@ -31,6 +31,7 @@
 #include <migraphx/eliminate_pad.hpp>
 #include <migraphx/insert_pad.hpp>
 #include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/env.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/normalize_ops.hpp>
 
@@ -38,6 +39,8 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace ref {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_UNROLL_RNN)
+
 std::string target::name() const { return "ref"; }
 
 std::vector<pass> target::get_passes(migraphx::context&, const compile_options&) const
@@ -47,7 +50,7 @@ std::vector<pass> target::get_passes(migraphx::context&, const compile_options&)
             dead_code_elimination{},
             insert_pad{},
             dead_code_elimination{},
-            rewrite_rnn{},
+            rewrite_rnn{enabled(MIGRAPHX_UNROLL_RNN{})},
             dead_code_elimination{},
             auto_contiguous{},
             dead_code_elimination{},
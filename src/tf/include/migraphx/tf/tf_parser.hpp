@@ -50,6 +50,8 @@ struct tf_parser
         attribute_map attributes{};
         std::string name = "";
         module* mm       = nullptr;
+        // Name of the node in the graph
+        std::string node_name = "";
 
         instruction_ref make_contiguous(instruction_ref ins) const;
 
@@ -89,6 +91,8 @@ struct tf_parser
     std::vector<tensorflow::NodeDef> input_nodes;
     std::vector<std::string> output_node_names;
     std::unordered_map<std::string, instruction_ref> instructions;
+    // Tensors of the Const nodes decoded ahead of parsing the nodes
+    std::unordered_map<std::string, literal> constants;
     program prog                  = program();
     module* mm                    = prog.get_main_module();
     bool is_nhwc                  = true;
@@ -127,6 +131,7 @@ struct tf_parser
     void parse_from(const void* data, std::size_t size);
     void parse_graph(const tensorflow::GraphDef& graph);
     void parse_node(const std::string& name);
+    void parse_constants();
     literal parse_tensor(const tensorflow::TensorProto& t) const;
     shape::type_t parse_type(tensorflow::DataType t) const;
     std::vector<std::string> find_outputs() const;
@@ -40,6 +40,8 @@ struct parse_constant_op : op_parser<parse_constant_op>
                           tf_parser::node_info info,
                           const std::vector<instruction_ref>& /*args*/) const
     {
+        if(contains(parser.constants, info.node_name))
+            return info.add_literal(parser.constants.at(info.node_name));
         literal v = parser.parse_tensor(info.attributes.at("value").tensor());
         return info.add_literal(v);
     }
@@ -42,6 +42,7 @@
 #include <migraphx/tf.hpp>
 #include <migraphx/common.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/dynamic_par_for.hpp>
 
 #include <migraphx/tf/tf_parser.hpp>
 #include <migraphx/tf/op_parser.hpp>
@@ -269,6 +270,7 @@ std::vector<std::string> tf_parser::find_outputs() const
 void tf_parser::parse_graph(const tensorflow::GraphDef& graph)
 {
     nodes = get_nodes(graph, input_nodes);
+    this->parse_constants();
     for(auto&& input : input_nodes)
     {
         const std::string& name   = input.name();
@@ -322,6 +324,36 @@ void tf_parser::parse_graph(const tensorflow::GraphDef& graph)
     }
 }
 
+void tf_parser::parse_constants()
+{
+    std::vector<std::pair<std::string, const tensorflow::TensorProto*>> tensors;
+    for(auto&& p : nodes)
+    {
+        if(p.second.op() != "Const" or p.second.attr().count("value") == 0)
+            continue;
+        tensors.emplace_back(p.first, &p.second.attr().at("value").tensor());
+    }
+    std::vector<literal> literals(tensors.size());
+    std::vector<char> decoded(tensors.size(), 0);
+    dynamic_par_for(tensors.size(), [&](auto i) {
+        // Constants that can't be decoded are parsed again when they are used, so that the error
+        // is only reported for constants that are reachable from the outputs
+        try
+        {
+            literals[i] = this->parse_tensor(*tensors[i].second);
+            decoded[i]  = 1;
+        }
+        catch(const std::exception&)
+        {
+        }
+    });
+    for(std::size_t i = 0; i < tensors.size(); i++)
+    {
+        if(decoded[i] != 0)
+            constants[tensors[i].first] = std::move(literals[i]);
+    }
+}
+
 void tf_parser::parse_node(const std::string& name)
 {
     if(instructions.count(name) == 0)
@@ -369,7 +401,9 @@ void tf_parser::parse_node(const std::string& name)
         }
         else
         {
-            result = ops[node.op()](*this, {get_attributes(node), node.op(), mm}, args);
+            // The tensor of a decoded constant is not needed so avoid copying it
+            auto attributes = contains(constants, name) ? attribute_map{} : get_attributes(node);
+            result = ops[node.op()](*this, {attributes, node.op(), mm, name}, args);
         }
         assert(not result.empty());
         // First output has no ":" delimiter
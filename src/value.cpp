@@ -29,12 +29,15 @@
 #include <migraphx/value.hpp>
 #include <migraphx/optional.hpp>
 #include <migraphx/hash.hpp>
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+struct object_value_holder;
+
 struct value_base_impl : cloneable<value_base_impl>
 {
     virtual value::type_t get_type() { return value::null_type; }
@@ -42,7 +45,7 @@ struct value_base_impl : cloneable<value_base_impl>
     virtual const cpp_type* if_##vt() const { return nullptr; }
     MIGRAPHX_VISIT_VALUE_TYPES(MIGRAPHX_VALUE_GENERATE_BASE_FUNCTIONS)
     virtual std::vector<value>* if_array() { return nullptr; }
-    virtual std::unordered_map<std::string, std::size_t>* if_object() { return nullptr; }
+    virtual object_value_holder* if_object() { return nullptr; }
     virtual value_base_impl* if_value() const { return nullptr; }
     value_base_impl()                       = default;
     value_base_impl(const value_base_impl&) = default;
@@ -71,16 +74,76 @@ struct array_value_holder : value_base_impl::derive<array_value_holder>
 
 struct object_value_holder : value_base_impl::derive<object_value_holder>
 {
+    // Most objects are operator attributes with only a few fields, so these are searched
+    // linearly. The hash table is only built for larger objects, and is never copied.
+    static constexpr std::size_t small_size = 16;
+
     object_value_holder() {}
-    object_value_holder(std::vector<value> d, std::unordered_map<std::string, std::size_t> l)
-        : data(std::move(d)), lookup(std::move(l))
+    object_value_holder(std::vector<value> d) : data(std::move(d)) {}
+    object_value_holder(const object_value_holder& rhs) : data(rhs.data) {}
+    object_value_holder& operator=(const object_value_holder& rhs)
     {
+        data = rhs.data;
+        lookup.clear();
+        indexed = 0;
+        return *this;
     }
     virtual value::type_t get_type() override { return value::object_type; }
     virtual std::vector<value>* if_array() override { return &data; }
-    virtual std::unordered_map<std::string, std::size_t>* if_object() override { return &lookup; }
+    virtual object_value_holder* if_object() override { return this; }
+
+    // Returns the index of the field with the key, or the size when it is not found. When
+    // there are duplicate keys the last one is used.
+    std::size_t find(const std::string& key)
+    {
+        if(data.size() <= small_size)
+        {
+            auto it = std::find_if(
+                data.rbegin(), data.rend(), [&](const value& v) { return v.get_key() == key; });
+            if(it == data.rend())
+                return data.size();
+            return std::distance(it, data.rend()) - 1;
+        }
+        // The fields can be changed through the array so rebuild the table when it is stale
+        if(indexed != data.size())
+            reindex();
+        auto it = lookup.find(key);
+        if(it != lookup.end() and data[it->second].get_key() != key)
+        {
+            reindex();
+            it = lookup.find(key);
+        }
+        if(it == lookup.end())
+            return data.size();
+        return it->second;
+    }
+
+    std::pair<std::size_t, bool> insert(const value& v)
+    {
+        auto i = find(v.get_key());
+        if(i != data.size())
+            return std::make_pair(i, false);
+        data.push_back(v);
+        if(indexed == i and not lookup.empty())
+        {
+            lookup.emplace(v.get_key(), i);
+            indexed++;
+        }
+        return std::make_pair(i, true);
+    }
+
+    void reindex()
+    {
+        lookup.clear();
+        lookup.reserve(data.size());
+        for(std::size_t i = 0; i < data.size(); i++)
+            lookup[data[i].get_key()] = i;
+        indexed = data.size();
+    }
+
     std::vector<value> data;
     std::unordered_map<std::string, std::size_t> lookup;
+    std::size_t indexed = 0;
 };
 
 value::value(const value& rhs) : x(rhs.x ? rhs.x->clone() : nullptr), key(rhs.key) {}
@@ -110,14 +173,7 @@ void set_vector(std::shared_ptr<value_base_impl>& x,
     }
     else
     {
-        std::unordered_map<std::string, std::size_t> lookup;
-        std::size_t i = 0;
-        for(auto&& e : v)
-        {
-            lookup[e.get_key()] = i;
-            i++;
-        }
-        x = std::make_shared<object_value_holder>(v, lookup);
+        x = std::make_shared<object_value_holder>(v);
     }
 }
 
@@ -259,16 +315,15 @@ std::vector<value>& get_array_throw(const std::shared_ptr<value_base_impl>& x)
 template <class T>
 T* find_impl(const std::shared_ptr<value_base_impl>& x, const std::string& key, T* end)
 {
-    auto* a = if_array_impl(x);
-    if(a == nullptr)
+    if(x == nullptr)
         return end;
-    auto* lookup = x->if_object();
-    if(lookup == nullptr)
+    auto* obj = x->if_object();
+    if(obj == nullptr)
         return end;
-    auto it = lookup->find(key);
-    if(it == lookup->end())
+    auto i = obj->find(key);
+    if(i == obj->data.size())
         return end;
-    return std::addressof((*a)[it->second]);
+    return std::addressof(obj->data[i]);
 }
 
 value* value::find(const std::string& pkey) { return find_impl(x, pkey, this->end()); }
@@ -411,11 +466,12 @@ std::pair<value*, bool> value::insert(const value& v)
     {
         if(not x)
             x = std::make_shared<object_value_holder>();
-        auto p = x->if_object()->emplace(v.key, get_array_impl(x).size());
-        if(p.second)
-            get_array_impl(x).push_back(v);
+        auto* obj = x->if_object();
+        if(obj == nullptr)
+            MIGRAPHX_THROW("Expected an object");
+        auto p = obj->insert(v);
         assert(this->if_object());
-        return std::make_pair(&get_array_impl(x)[p.first->second], p.second);
+        return std::make_pair(&obj->data[p.first], p.second);
     }
 }
 value* value::insert(const value* pos, const value& v)
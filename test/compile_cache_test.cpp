@@ -0,0 +1,146 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/compile_cache.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/tmp_dir.hpp>
+#include <migraphx/file_buffer.hpp>
+#include "test.hpp"
+
+migraphx::program create_program(int n = 2)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto two = mm->add_literal(n);
+    auto add = mm->add_instruction(migraphx::make_op("add"), x, two);
+    mm->add_return({add});
+    return p;
+}
+
+std::size_t count_entries(const migraphx::fs::path& dir)
+{
+    return std::distance(migraphx::fs::directory_iterator(dir),
+                         migraphx::fs::directory_iterator{});
+}
+
+TEST_CASE(cache_key)
+{
+    auto t = migraphx::make_target("ref");
+    auto k = migraphx::compile_cache::key(create_program(), t);
+    EXPECT(k == migraphx::compile_cache::key(create_program(), t));
+    EXPECT(k != migraphx::compile_cache::key(create_program(3), t));
+    migraphx::compile_options options;
+    options.fast_math = false;
+    EXPECT(k != migraphx::compile_cache::key(create_program(), t, options));
+    // Options that dont change the compiled program dont change the key
+    options.fast_math = true;
+    options.cache_dir = "cache";
+    EXPECT(k == migraphx::compile_cache::key(create_program(), t, options));
+}
+
+TEST_CASE(cache_store_load)
+{
+    migraphx::tmp_dir td{"compile_cache"};
+    migraphx::compile_cache cache{td.path};
+    auto t = migraphx::make_target("ref");
+    auto p = create_program();
+    auto k = migraphx::compile_cache::key(p, t);
+    EXPECT(not cache.contains(k));
+    EXPECT(not cache.load(k).has_value());
+    p.compile(t);
+    cache.store(k, p);
+    EXPECT(cache.contains(k));
+    EXPECT(count_entries(td.path) == 1);
+    auto cached = cache.load(k);
+    EXPECT(cached.has_value());
+    EXPECT(cached->is_compiled());
+    EXPECT(*cached == p);
+}
+
+TEST_CASE(cache_corrupt_entry)
+{
+    migraphx::tmp_dir td{"compile_cache"};
+    migraphx::compile_cache cache{td.path};
+    auto t = migraphx::make_target("ref");
+    auto k = migraphx::compile_cache::key(create_program(), t);
+    std::string garbage = "not a program";
+    migraphx::write_buffer((td.path / (k + ".mxr")).string(), garbage.data(), garbage.size());
+    EXPECT(cache.contains(k));
+    EXPECT(not cache.load(k).has_value());
+    EXPECT(not cache.contains(k));
+}
+
+TEST_CASE(cache_evict)
+{
+    migraphx::tmp_dir td{"compile_cache"};
+    auto t = migraphx::make_target("ref");
+    std::vector<std::string> keys;
+    for(int i = 0; i < 3; i++)
+    {
+        auto p = create_program(i);
+        keys.push_back(migraphx::compile_cache::key(p, t));
+        p.compile(t);
+        migraphx::compile_cache{td.path}.store(keys.back(), p);
+    }
+    migraphx::compile_cache unbounded{td.path};
+    EXPECT(count_entries(td.path) == 3);
+    auto entry_size = unbounded.size() / 3;
+    // Make the first entry the most recently used
+    EXPECT(unbounded.load(keys[0]).has_value());
+    migraphx::compile_cache cache{td.path, 2 * entry_size + entry_size / 2};
+    cache.evict();
+    EXPECT(count_entries(td.path) == 2);
+    EXPECT(cache.contains(keys[0]));
+    EXPECT(cache.size() <= 2 * entry_size + entry_size / 2);
+}
+
+TEST_CASE(compile_with_cache)
+{
+    migraphx::tmp_dir td{"compile_cache"};
+    auto t = migraphx::make_target("ref");
+    migraphx::compile_options options;
+    options.cache_dir = td.path.string();
+
+    auto p1 = create_program();
+    p1.compile(t, options);
+    EXPECT(count_entries(td.path) == 1);
+
+    auto p2 = create_program();
+    p2.compile(t, options);
+    EXPECT(count_entries(td.path) == 1);
+    EXPECT(p2.is_compiled());
+    EXPECT(p1 == p2);
+
+    migraphx::parameter_map params;
+    std::vector<int> x = {5};
+    params["x"]        = migraphx::argument(migraphx::shape{migraphx::shape::int32_type}, x.data());
+    auto result        = p2.eval(params).back();
+    EXPECT(result == migraphx::literal{7});
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,128 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/copy_layout.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/permutation.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include "test.hpp"
+
+static migraphx::argument copy_elements(const migraphx::argument& src, const migraphx::shape& s)
+{
+    migraphx::argument result{s};
+    migraphx::visit_all(result, src)([&](auto output, auto input) {
+        migraphx::shape_for_each(s, [&](const auto& idx) {
+            output(idx.begin(), idx.end()) = input(idx.begin(), idx.end());
+        });
+    });
+    return result;
+}
+
+static bool check_copy(const migraphx::shape& src_shape, const migraphx::shape& dst_shape)
+{
+    auto src = migraphx::generate_argument(src_shape);
+    migraphx::argument dst{dst_shape};
+    migraphx::copy_layout(src, dst);
+    return dst == copy_elements(src, dst_shape);
+}
+
+static migraphx::shape permuted(migraphx::shape::type_t t,
+                                const std::vector<std::size_t>& lens,
+                                const std::vector<int64_t>& perm)
+{
+    return migraphx::shape::from_permutation(t, lens, perm);
+}
+
+TEST_CASE(copy_standard)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3, 4, 5}};
+    EXPECT(check_copy(s, s));
+}
+
+TEST_CASE(copy_scalar)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1}, {0}};
+    EXPECT(check_copy(s, migraphx::shape{migraphx::shape::float_type, {1}}));
+}
+
+TEST_CASE(copy_transpose_2d)
+{
+    for(auto t : {migraphx::shape::int8_type,
+                  migraphx::shape::half_type,
+                  migraphx::shape::float_type,
+                  migraphx::shape::double_type})
+    {
+        migraphx::shape src{t, {67, 130}, {1, 67}};
+        EXPECT(check_copy(src, migraphx::shape{t, {67, 130}}));
+    }
+}
+
+TEST_CASE(copy_nchw_to_nhwc)
+{
+    migraphx::shape src{migraphx::shape::float_type, {2, 19, 7, 9}};
+    auto dst = permuted(migraphx::shape::float_type, {2, 19, 7, 9}, {0, 2, 3, 1});
+    EXPECT(check_copy(src, dst));
+    EXPECT(check_copy(dst, src));
+}
+
+TEST_CASE(copy_attention_heads)
+{
+    auto src = permuted(migraphx::shape::float_type, {2, 4, 33, 16}, {0, 2, 1, 3});
+    EXPECT(check_copy(src, migraphx::shape{migraphx::shape::float_type, {2, 4, 33, 16}}));
+}
+
+TEST_CASE(copy_broadcast)
+{
+    migraphx::shape src{migraphx::shape::float_type, {3, 40, 5}, {0, 1, 0}};
+    EXPECT(check_copy(src, migraphx::shape{migraphx::shape::float_type, {3, 40, 5}}));
+}
+
+TEST_CASE(copy_sliced)
+{
+    migraphx::shape src{migraphx::shape::float_type, {4, 3, 6}, {48, 12, 1}};
+    EXPECT(check_copy(src, migraphx::shape{migraphx::shape::float_type, {4, 3, 6}}));
+}
+
+TEST_CASE(copy_large_transpose)
+{
+    migraphx::shape src{migraphx::shape::float_type, {8, 300, 257}, {300 * 257, 1, 300}};
+    EXPECT(check_copy(src, migraphx::shape{migraphx::shape::float_type, {8, 300, 257}}));
+}
+
+TEST_CASE(copy_large_contiguous)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1024, 1024}};
+    EXPECT(check_copy(s, s));
+}
+
+TEST_CASE(copy_mismatched_lens)
+{
+    migraphx::shape s1{migraphx::shape::float_type, {2, 3}};
+    migraphx::shape s2{migraphx::shape::float_type, {3, 2}};
+    migraphx::argument a1{s1};
+    migraphx::argument a2{s2};
+    EXPECT(test::throws([&] { migraphx::copy_layout(a1, a2); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
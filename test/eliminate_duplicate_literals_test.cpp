@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <migraphx/eliminate_duplicate_literals.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/make_op.hpp>
+#include <test.hpp>
+
+void run_pass(migraphx::program& p)
+{
+    migraphx::run_passes(p, {migraphx::eliminate_duplicate_literals{}});
+}
+
+TEST_CASE(duplicate_literals_same_module)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto l1   = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+        auto l2   = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+        auto add1 = mm->add_instruction(migraphx::make_op("add"), x, l1);
+        auto add2 = mm->add_instruction(migraphx::make_op("add"), add1, l2);
+        mm->add_return({add2});
+    }
+    run_pass(p1);
+
+    migraphx::program p2;
+    {
+        auto* mm  = p2.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto l1   = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+        auto add1 = mm->add_instruction(migraphx::make_op("add"), x, l1);
+        auto add2 = mm->add_instruction(migraphx::make_op("add"), add1, l1);
+        mm->add_return({add2});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(different_literals)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto l1   = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+        auto l2   = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 7}});
+        auto add1 = mm->add_instruction(migraphx::make_op("add"), x, l1);
+        auto add2 = mm->add_instruction(migraphx::make_op("add"), add1, l2);
+        mm->add_return({add2});
+    }
+    migraphx::program p2 = p1;
+    run_pass(p1);
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(duplicate_literals_shared_across_modules)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p;
+    auto* mm  = p.get_main_module();
+    auto x    = mm->add_parameter("x", s);
+    auto l1   = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+    auto add1 = mm->add_instruction(migraphx::make_op("add"), x, l1);
+    mm->add_return({add1});
+    auto* sm  = p.create_module("sub");
+    auto y    = sm->add_parameter("y", s);
+    auto l2   = sm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+    auto add2 = sm->add_instruction(migraphx::make_op("add"), y, l2);
+    sm->add_return({add2});
+    EXPECT(not l1->get_literal().shares_buffer(l2->get_literal()));
+
+    run_pass(p);
+    EXPECT(mm->size() == 4);
+    EXPECT(sm->size() == 4);
+    auto lit = add2->inputs().back();
+    EXPECT(lit->name() == "@literal");
+    EXPECT(sm->has_instruction(lit));
+    EXPECT(lit->get_literal().shares_buffer(l1->get_literal()));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,141 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/host_buffer_pool.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/literal.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include "test.hpp"
+
+static bool is_aligned(const char* p, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+TEST_CASE(pool_alignment)
+{
+    migraphx::host_buffer_pool pool{256, 1 << 20};
+    EXPECT(pool.alignment() == 256);
+    for(std::size_t n : {0, 1, 7, 64, 255, 1000, 4097})
+    {
+        auto b = pool.allocate(n);
+        EXPECT(b != nullptr);
+        EXPECT(is_aligned(b.get(), 256));
+    }
+}
+
+TEST_CASE(pool_bad_alignment)
+{
+    EXPECT(test::throws([] { migraphx::host_buffer_pool{48, 0}; }));
+}
+
+TEST_CASE(pool_reuse)
+{
+    migraphx::host_buffer_pool pool{64, 1 << 20};
+    const char* p = nullptr;
+    {
+        auto b = pool.allocate(1000);
+        p      = b.get();
+        std::fill(b.get(), b.get() + 1000, 7);
+        EXPECT(pool.get_statistics().bytes_in_use >= 1000);
+    }
+    auto s1 = pool.get_statistics();
+    EXPECT(s1.bytes_in_use == 0);
+    EXPECT(s1.bytes_cached >= 1000);
+    // A request in the same size class gets the released buffer back, zeroed
+    auto b = pool.allocate(990);
+    EXPECT(b.get() == p);
+    EXPECT(std::all_of(b.get(), b.get() + 990, [](char c) { return c == 0; }));
+    auto s2 = pool.get_statistics();
+    EXPECT(s2.allocations == 2);
+    EXPECT(s2.reuses == 1);
+    EXPECT(s2.bytes_cached == 0);
+    EXPECT(s2.peak_bytes_in_use == s1.peak_bytes_in_use);
+}
+
+TEST_CASE(pool_limit)
+{
+    migraphx::host_buffer_pool pool{64, 0};
+    pool.allocate(1000);
+    auto s = pool.get_statistics();
+    EXPECT(s.bytes_cached == 0);
+    EXPECT(s.reuses == 0);
+    pool.allocate(1000);
+    EXPECT(pool.get_statistics().reuses == 0);
+}
+
+TEST_CASE(pool_release)
+{
+    migraphx::host_buffer_pool pool{64, 1 << 20};
+    pool.allocate(100);
+    pool.allocate(5000);
+    EXPECT(pool.get_statistics().bytes_cached > 0);
+    pool.release();
+    EXPECT(pool.get_statistics().bytes_cached == 0);
+    pool.allocate(100);
+    EXPECT(pool.get_statistics().reuses == 0);
+}
+
+TEST_CASE(pool_outlives)
+{
+    std::shared_ptr<char> b;
+    {
+        migraphx::host_buffer_pool pool{64, 1 << 20};
+        b = pool.allocate(128);
+    }
+    std::memset(b.get(), 1, 128);
+    EXPECT(b.get()[127] == 1);
+}
+
+TEST_CASE(pool_statistics_print)
+{
+    migraphx::host_buffer_pool pool{64, 1 << 20};
+    auto b = pool.allocate(64);
+    std::stringstream ss;
+    ss << pool.get_statistics();
+    EXPECT(ss.str().find("allocations: 1") != std::string::npos);
+}
+
+TEST_CASE(scoped_pool_argument)
+{
+    migraphx::host_buffer_pool pool{128, 1 << 20};
+    migraphx::shape s{migraphx::shape::float_type, {3, 5}};
+    {
+        migraphx::scoped_host_buffer_pool scope{pool};
+        EXPECT(&migraphx::current_host_buffer_pool() == &pool);
+        migraphx::argument a{s};
+        migraphx::literal l{s, std::vector<float>(15, 1.0f)};
+        EXPECT(is_aligned(a.data(), 128));
+        EXPECT(is_aligned(l.data(), 128));
+        EXPECT(pool.get_statistics().allocations == 2);
+    }
+    EXPECT(&migraphx::current_host_buffer_pool() == &migraphx::host_buffer_pool::global());
+    EXPECT(pool.get_statistics().bytes_in_use == 0);
+    migraphx::argument a{s};
+    EXPECT(pool.get_statistics().allocations == 2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -49,6 +49,24 @@ TEST_CASE(literal_test)
     EXPECT(l4.empty());
 }
 
+TEST_CASE(literal_hash)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 2}};
+    migraphx::literal l1{s, {1, 2, 3, 4}};
+    migraphx::literal l2{s, {1, 2, 3, 4}};
+    migraphx::literal l3{s, {1, 2, 3, 5}};
+    migraphx::literal l4{migraphx::shape{migraphx::shape::float_type, {4}}, {1, 2, 3, 4}};
+    EXPECT(l1.hash() == l2.hash());
+    EXPECT(l1.hash() != l3.hash());
+    EXPECT(l1.hash() != l4.hash());
+    EXPECT(migraphx::literal{}.hash() == migraphx::literal{}.hash());
+
+    migraphx::literal l5 = l1; // NOLINT
+    EXPECT(l5.shares_buffer(l1));
+    EXPECT(not l2.shares_buffer(l1));
+    EXPECT(not migraphx::literal{}.shares_buffer(migraphx::literal{}));
+}
+
 TEST_CASE(literal_nstd_shape_vector)
 {
     migraphx::shape nstd_shape{migraphx::shape::float_type, {1, 3, 2, 2}, {12, 1, 6, 3}};
@@ -1086,4 +1086,88 @@ TEST_CASE(match_finder)
     match::find_matches(mm, match_find_sum{sum}, match_find_literal{sum});
 }
 
+struct match_find_sum_count
+{
+    std::size_t* count;
+    auto matcher() const { return match::name("sum"); }
+
+    void apply(migraphx::module&, const match::matcher_result& r) const
+    {
+        EXPECT(r.result->name() == "sum");
+        (*count)++;
+    }
+};
+
+struct match_find_any_count
+{
+    std::size_t* count;
+    auto matcher() const { return match::any(); }
+
+    void apply(migraphx::module&, const match::matcher_result&) const { (*count)++; }
+};
+
+TEST_CASE(match_finder_root_names)
+{
+    migraphx::module mm;
+    auto one  = mm.add_literal(1);
+    auto two  = mm.add_literal(2);
+    auto sum1 = mm.add_instruction(sum_op{}, one, two);
+    auto sum2 = mm.add_instruction(sum_op{}, sum1, two);
+    mm.add_instruction(pass_op{}, sum2);
+    std::size_t sum_count = 0;
+    std::size_t any_count = 0;
+    match::find_matches(mm, match_find_sum_count{&sum_count}, match_find_any_count{&any_count});
+    EXPECT(sum_count == 2);
+    EXPECT(any_count == 3);
+}
+
+static std::unordered_set<std::string> get_root_names(const match::root_name_set& names)
+{
+    EXPECT(names.has_value());
+    if(not names)
+        return {};
+    return *names;
+}
+
+TEST_CASE(match_root_names_name)
+{
+    using names = std::unordered_set<std::string>;
+    EXPECT(get_root_names(match::root_names(match::name("sum"))) == names{"sum"});
+    EXPECT(get_root_names(match::root_names(match::name("sum", "pass"))) ==
+           names{"sum", "pass"});
+    EXPECT(get_root_names(match::root_names(match::name(names{"sum", "pass"}))) ==
+           names{"sum", "pass"});
+    EXPECT(get_root_names(match::root_names(match::name("sum").bind("x"))) == names{"sum"});
+}
+
+TEST_CASE(match_root_names_args)
+{
+    using names = std::unordered_set<std::string>;
+    auto m1 = match::name("sum")(match::arg(0)(match::name("@literal")), match::standard_shape());
+    EXPECT(get_root_names(match::root_names(m1)) == names{"sum"});
+    auto m2 = match::name("sum")(match::args(match::any(), match::any())).bind("x");
+    EXPECT(get_root_names(match::root_names(m2)) == names{"sum"});
+    EXPECT(not match::root_names(match::arg(0)(match::name("sum"))).has_value());
+    EXPECT(not match::root_names(match::standard_shape()).has_value());
+    EXPECT(not match::root_names(match::skip(match::name("pass"))(match::name("sum")))
+                   .has_value());
+}
+
+TEST_CASE(match_root_names_fold)
+{
+    using names = std::unordered_set<std::string>;
+    auto m1     = match::any_of(match::name("sum"), match::name("pass"));
+    EXPECT(get_root_names(match::root_names(m1)) == names{"sum", "pass"});
+    auto m2 = match::any_of(match::name("sum"), match::standard_shape());
+    EXPECT(not match::root_names(m2).has_value());
+    auto m3 = match::all_of(match::name("sum", "pass"), match::name("pass", "@literal"));
+    EXPECT(get_root_names(match::root_names(m3)) == names{"pass"});
+    auto m4 = match::all_of(match::name("sum"), match::standard_shape());
+    EXPECT(get_root_names(match::root_names(m4)) == names{"sum"});
+    auto m5 = match::none_of(match::name("sum"));
+    EXPECT(not match::root_names(m5).has_value());
+    auto m6 = match::any_of(match::name("sum"), match::name("pass")).bind("x");
+    EXPECT(get_root_names(match::root_names(m6)) == names{"sum", "pass"});
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
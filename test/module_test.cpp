@@ -134,6 +134,30 @@ TEST_CASE(module_ins_clear)
     EXPECT(p1 == p2);
 }
 
+TEST_CASE(module_change_count)
+{
+    migraphx::module m;
+    auto x     = m.add_parameter("x", {migraphx::shape::int64_type});
+    auto one   = m.add_literal(1);
+    auto start = m.get_change_count();
+    auto sum   = m.add_instruction(sum_op{}, x, one);
+    EXPECT(m.get_change_count() > start);
+
+    auto validated = m.get_change_count();
+    m.validate();
+    m.get_parameter_shapes();
+    EXPECT(m.get_change_count() == validated);
+
+    auto added = m.get_change_count();
+    auto pass  = m.add_instruction(pass_op{}, sum);
+    m.replace_instruction(sum, minus_op{}, x, one);
+    EXPECT(m.get_change_count() > added);
+
+    auto replaced = m.get_change_count();
+    m.remove_instruction(pass);
+    EXPECT(m.get_change_count() > replaced);
+}
+
 TEST_CASE(module_name)
 {
     migraphx::module m1("name");
@@ -3746,6 +3746,30 @@ def initializer_not_an_input():
     return ([node], [x], [y], [w])
 
 
+@onnx_test()
+def initializer_unused_test():
+    w = helper.make_tensor(name='w',
+                           data_type=TensorProto.FLOAT,
+                           dims=[2],
+                           vals=[1.0, 2.0])
+    u = helper.make_tensor(name='u',
+                           data_type=TensorProto.FLOAT,
+                           dims=[3],
+                           vals=[1.0, 2.0, 3.0])
+
+    x = helper.make_tensor_value_info('x', TensorProto.FLOAT, [2])
+    u_input = helper.make_tensor_value_info('u', TensorProto.FLOAT, [3])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [2])
+
+    node = onnx.helper.make_node(
+        'Add',
+        inputs=['x', 'w'],
+        outputs=['y'],
+    )
+
+    return ([node], [x, u_input], [y], [w, u])
+
+
 @onnx_test()
 def instance_norm_test():
     x = helper.make_tensor_value_info('0', TensorProto.FLOAT, [1, 2, 3, 3])
@@ -38,12 +38,13 @@ TEST_CASE(resize_downsample_c_test)
 
     mm->add_instruction(migraphx::make_op("undefined"));
 
-    migraphx::shape si{migraphx::shape::int32_type, {1, 1, 1, 2}};
-    std::vector<int> ind = {0, 2};
-    auto li              = mm->add_literal(migraphx::literal(si, ind));
-
-    auto lrsp = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {8}}}), inx);
-    auto r    = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), lrsp, li);
+    auto r = mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "nearest"},
+                           {"coordinate_transformation_mode", "asymmetric"},
+                           {"nearest_mode", "ceil"},
+                           {"scales", {1.0f, 1.0f, 0.6f, 0.6f}}}),
+        inx);
     mm->add_return({r});
 
     auto prog = migraphx::parse_onnx("resize_downsample_c_test.onnx");
@@ -37,12 +37,13 @@ TEST_CASE(resize_downsample_f_test)
 
     mm->add_instruction(migraphx::make_op("undefined"));
 
-    migraphx::shape si{migraphx::shape::int32_type, {1, 1, 1, 2}};
-    std::vector<int> ind = {0, 3};
-    auto li              = mm->add_literal(migraphx::literal(si, ind));
-
-    auto lrsp = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {8}}}), inx);
-    auto r    = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), lrsp, li);
+    auto r = mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "nearest"},
+                           {"coordinate_transformation_mode", "align_corners"},
+                           {"nearest_mode", "floor"},
+                           {"scales", {1.0f, 1.0f, 0.6f, 0.6f}}}),
+        inx);
     mm->add_return({r});
 
     auto prog = migraphx::parse_onnx("resize_downsample_f_test.onnx");
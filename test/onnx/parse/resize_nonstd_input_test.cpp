@@ -36,16 +36,17 @@ TEST_CASE(resize_nonstd_input_test)
     migraphx::shape sx{migraphx::shape::float_type, {1, 1, 4, 2}};
     auto inx = mm->add_parameter("X", sx);
 
-    migraphx::shape si{migraphx::shape::int32_type, {1, 1, 1, 2}};
-    std::vector<int> ind = {0, 4};
-    auto li              = mm->add_literal(migraphx::literal(si, ind));
-
     auto tx =
         mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 1, 3, 2}}}), inx);
     mm->add_instruction(migraphx::make_op("undefined"));
 
-    auto lrsp = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {8}}}), tx);
-    auto r    = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), lrsp, li);
+    auto r = mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "nearest"},
+                           {"coordinate_transformation_mode", "asymmetric"},
+                           {"nearest_mode", "ceil"},
+                           {"scales", {1.0f, 1.0f, 0.6f, 0.6f}}}),
+        tx);
     mm->add_return({r});
 
     auto prog = migraphx::parse_onnx("resize_nonstd_input_test.onnx");
@@ -38,12 +38,13 @@ TEST_CASE(resize_outsize_test)
 
     mm->add_instruction(migraphx::make_op("undefined"));
 
-    migraphx::shape si{migraphx::shape::int32_type, {1, 1, 4, 6}};
-    std::vector<int> ind = {0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 3, 3, 2, 2, 3, 3, 3, 3, 2, 2, 3, 3, 3, 3};
-    auto li              = mm->add_literal(migraphx::literal(si, ind));
-
-    auto lrsp = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {4}}}), inx);
-    auto r    = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), lrsp, li);
+    auto r = mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "nearest"},
+                           {"coordinate_transformation_mode", "tf_half_pixel_for_nn"},
+                           {"nearest_mode", "round_prefer_floor"},
+                           {"sizes", {1, 1, 4, 6}}}),
+        inx);
     mm->add_return({r});
 
     auto prog = migraphx::parse_onnx("resize_outsize_test.onnx");
@@ -27,7 +27,7 @@
 
 TEST_CASE(resize_upsample_linear_ac_test)
 {
-    auto p    = create_upsample_linear_prog();
+    auto p    = create_upsample_linear_prog("align_corners");
     auto prog = migraphx::parse_onnx("resize_upsample_linear_ac_test.onnx");
     EXPECT(p == prog);
 }
@@ -38,12 +38,13 @@ TEST_CASE(resize_upsample_pc_test)
 
     mm->add_instruction(migraphx::make_op("undefined"));
 
-    migraphx::shape si{migraphx::shape::int32_type, {1, 1, 4, 6}};
-    std::vector<int> ind = {0, 1, 1, 2, 3, 3, 0, 1, 1, 2, 3, 3, 4, 5, 5, 6, 7, 7, 4, 5, 5, 6, 7, 7};
-    auto li              = mm->add_literal(migraphx::literal(si, ind));
-
-    auto lrsp = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {8}}}), inx);
-    auto r    = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), lrsp, li);
+    auto r = mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "nearest"},
+                           {"coordinate_transformation_mode", "pytorch_half_pixel"},
+                           {"nearest_mode", "round_prefer_ceil"},
+                           {"scales", {1.0f, 1.0f, 2.0f, 1.5f}}}),
+        inx);
     mm->add_return({r});
 
     auto prog = migraphx::parse_onnx("resize_upsample_pc_test.onnx");
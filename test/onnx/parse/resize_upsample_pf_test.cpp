@@ -38,12 +38,9 @@ TEST_CASE(resize_upsample_pf_test)
 
     mm->add_instruction(migraphx::make_op("undefined"));
 
-    migraphx::shape si{migraphx::shape::int32_type, {1, 1, 4, 6}};
-    std::vector<int> ind = {0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 2, 2, 2, 3, 3, 3};
-    auto li              = mm->add_literal(migraphx::literal(si, ind));
-
-    auto lrsp = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {4}}}), inx);
-    auto r    = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), lrsp, li);
+    auto r = mm->add_instruction(
+        migraphx::make_op("resize", {{"mode", "nearest"}, {"scales", {1.0f, 1.0f, 2.0f, 3.0f}}}),
+        inx);
     mm->add_return({r});
 
     auto prog = migraphx::parse_onnx("resize_upsample_pf_test.onnx");
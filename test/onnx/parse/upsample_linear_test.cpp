@@ -27,7 +27,7 @@
 
 TEST_CASE(upsample_linear_test)
 {
-    auto p    = create_upsample_linear_prog();
+    auto p    = create_upsample_linear_prog("half_pixel");
     auto prog = migraphx::parse_onnx("upsample_linear_test.onnx");
     EXPECT(p == prog);
 }
@@ -3095,6 +3095,35 @@ TEST_CASE(reshape_lazy_non_fixed_not_matching_error)
     throws_shape(migraphx::make_op("reshape_lazy", {{"dims", new_shape}}), input);
 }
 
+TEST_CASE(resize_scales_shape)
+{
+    migraphx::shape input{migraphx::shape::float_type, {1, 3, 4, 5}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {1, 3, 8, 3}},
+                 migraphx::make_op("resize", {{"scales", {1.0, 1.0, 2.0, 0.6}}}),
+                 input);
+}
+
+TEST_CASE(resize_sizes_shape)
+{
+    migraphx::shape input{migraphx::shape::float_type, {1, 3, 4, 5}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {1, 3, 7, 2}},
+                 migraphx::make_op("resize", {{"sizes", {1, 3, 7, 2}}, {"mode", "cubic"}}),
+                 input);
+}
+
+TEST_CASE(resize_rank_error)
+{
+    migraphx::shape input{migraphx::shape::float_type, {1, 3, 4, 5}};
+    throws_shape(migraphx::make_op("resize", {{"scales", {2.0, 2.0}}}), input);
+}
+
+TEST_CASE(resize_mode_error)
+{
+    migraphx::shape input{migraphx::shape::float_type, {1, 3, 4, 5}};
+    throws_shape(
+        migraphx::make_op("resize", {{"scales", {1.0, 1.0, 2.0, 2.0}}, {"mode", "area"}}), input);
+}
+
 TEST_CASE(return_shape_tuple)
 {
     using migraphx::shape;
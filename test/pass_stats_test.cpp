@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/pass_stats.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <sstream>
+
+#include <test.hpp>
+
+struct nested_pass
+{
+    std::string name() const { return "nested_pass"; }
+    void apply(migraphx::module_pass_manager& mpm) const
+    {
+        mpm.run_pass(migraphx::dead_code_elimination{});
+    }
+};
+
+migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto one = mm->add_literal(1);
+    auto two = mm->add_literal(2);
+    mm->add_instruction(migraphx::make_op("add"), one, two);
+    mm->add_instruction(migraphx::make_op("mul"), one, two);
+    return p;
+}
+
+TEST_CASE(record_dead_code_elimination)
+{
+    auto p = create_program();
+    migraphx::pass_stats stats;
+    migraphx::run_passes(p, {migraphx::dead_code_elimination{}}, {}, &stats);
+    EXPECT(stats.names() == std::vector<std::string>{"dead_code_elimination"});
+    const auto& r = stats.get("dead_code_elimination");
+    EXPECT(r.calls == 1);
+    EXPECT(r.modules == 1);
+    EXPECT(r.instructions_before == 4);
+    EXPECT(r.instructions_after == 3);
+    EXPECT(r.total_ms >= 0);
+    EXPECT(r.max_ms <= r.total_ms);
+    EXPECT(r.peak_rss_delta_kb >= 0);
+}
+
+TEST_CASE(aggregate_repeated_passes)
+{
+    auto p = create_program();
+    migraphx::pass_stats stats;
+    migraphx::run_passes(
+        p, {migraphx::dead_code_elimination{}, migraphx::dead_code_elimination{}}, {}, &stats);
+    migraphx::run_passes(*p.get_main_module(), {migraphx::dead_code_elimination{}}, {}, &stats);
+    const auto& r = stats.get("dead_code_elimination");
+    EXPECT(r.calls == 3);
+    EXPECT(r.modules == 1);
+    EXPECT(r.instructions_before == 10);
+    EXPECT(r.instructions_after == 9);
+}
+
+TEST_CASE(record_nested_passes)
+{
+    auto p = create_program();
+    migraphx::pass_stats stats;
+    migraphx::run_passes(p, {nested_pass{}}, {}, &stats);
+    EXPECT(stats.names() == std::vector<std::string>{"dead_code_elimination", "nested_pass"});
+    EXPECT(stats.get("nested_pass").calls == 1);
+    EXPECT(stats.get("dead_code_elimination").calls == 1);
+    EXPECT(stats.get("nested_pass").instructions_after == 3);
+    EXPECT(not stats.contains("eliminate_identity"));
+    EXPECT(test::throws([&] { stats.get("eliminate_identity"); }));
+}
+
+TEST_CASE(pass_stats_to_value)
+{
+    auto p = create_program();
+    migraphx::pass_stats stats;
+    migraphx::run_passes(p, {migraphx::dead_code_elimination{}}, {}, &stats);
+    auto v = stats.to_value();
+    EXPECT(v.at("passes").size() == 1);
+    auto pv = v.at("passes").front();
+    EXPECT(pv.at("name").to<std::string>() == "dead_code_elimination");
+    EXPECT(pv.at("calls").to<std::size_t>() == 1);
+    EXPECT(pv.at("instructions_before").to<std::size_t>() == 4);
+    EXPECT(pv.at("instructions_after").to<std::size_t>() == 3);
+    std::stringstream ss;
+    stats.print(ss);
+    EXPECT(ss.str().find("dead_code_elimination") != std::string::npos);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -81,3 +81,29 @@ TEST_CASE(dequantizelinear_signed_int8)
     std::vector<float> gold{-256, -200, -100, -2, 0, 2, 100, 200, 254};
     EXPECT(results_vector == gold);
 }
+
+TEST_CASE(dequantizelinear_per_axis)
+{
+    migraphx::shape xs{migraphx::shape::int8_type, {2, 3}};
+    std::vector<int8_t> xv = {-128, 0, 127, 10, 20, 30};
+    migraphx::shape ss{migraphx::shape::float_type, {3}};
+    std::vector<float> sv = {1, 0.5, 2};
+    migraphx::shape zs{migraphx::shape::int8_type, {3}};
+    std::vector<int8_t> zv = {0, 10, -1};
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(xs, xv);
+    auto s   = mm->add_literal(ss, sv);
+    auto z   = mm->add_literal(zs, zv);
+    auto bs  = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", xs.lens()}}), s);
+    auto bz  = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", xs.lens()}}), z);
+    mm->add_instruction(migraphx::make_op("dequantizelinear"), x, bs, bz);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{-128, -5, 256, 10, 5, 62};
+    EXPECT(results_vector == gold);
+}
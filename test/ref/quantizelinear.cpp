@@ -21,6 +21,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <migraphx/float8.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/make_op.hpp>
@@ -83,3 +84,97 @@ TEST_CASE(quantizelinear_2)
     std::vector<float> gold{0, 255, 64, 0, 2, 2, 0, 255, 255, 0, 255, 64, 0, 2, 2, 0, 255, 255};
     EXPECT(results_vector == gold);
 }
+
+TEST_CASE(quantizelinear_per_axis)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {2, 2, 3}};
+    std::vector<float> xv = {1, 3, 5, 0.25, 0.75, -0.25, -1, -3, 255, 10, -100, 1.25};
+    migraphx::shape ss{migraphx::shape::float_type, {2}};
+    std::vector<float> sv = {2, 0.5};
+    migraphx::shape zs{migraphx::shape::int8_type, {2}};
+    std::vector<int8_t> zv = {1, -1};
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(xs, xv);
+    auto s   = mm->add_literal(ss, sv);
+    auto z   = mm->add_literal(zs, zv);
+    auto bs  = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", xs.lens()}}), s);
+    auto bz  = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", xs.lens()}}), z);
+    mm->add_instruction(migraphx::make_op("quantizelinear"), x, bs, bz);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    // Ties round to even: 0.5 -> 0, 1.5 -> 2, 2.5 -> 2, -0.5 -> 0, -1.5 -> -2
+    std::vector<float> gold{1, 3, 3, -1, 1, -1, 1, -1, 127, 19, -128, 1};
+    EXPECT(results_vector == gold);
+}
+
+TEST_CASE(quantizelinear_scalar_scale)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {4}};
+    std::vector<float> xv = {0.25, 0.75, -3, 200};
+    migraphx::shape ss{migraphx::shape::float_type};
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(xs, xv);
+    auto s   = mm->add_literal(migraphx::literal{ss, {0.5f}});
+    auto bs  = mm->add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", xs.lens()}}), s);
+    mm->add_instruction(migraphx::make_op("quantizelinear"), x, bs);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{0, 2, 0, 255};
+    EXPECT(results_vector == gold);
+}
+
+TEST_CASE(quantizelinear_transposed)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {2, 3}};
+    std::vector<float> xv = {1, 2, 3, 4, 5, 6};
+    migraphx::shape ss{migraphx::shape::float_type, {2}};
+    std::vector<float> sv = {1, 2};
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(xs, xv);
+    auto s   = mm->add_literal(ss, sv);
+    auto xt  = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), x);
+    auto bs  = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", xt->get_shape().lens()}}), s);
+    mm->add_instruction(migraphx::make_op("quantizelinear"), xt, bs);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{1, 2, 2, 2, 3, 3};
+    EXPECT(results_vector == gold);
+}
+
+TEST_CASE(quantizelinear_fp8)
+{
+    using migraphx::fp8::fp8e4m3fnuz;
+    migraphx::shape xs{migraphx::shape::float_type, {4}};
+    std::vector<float> xv = {1.3, -2.6, 1000, -1000};
+    migraphx::shape ss{migraphx::shape::float_type, {4}};
+    std::vector<float> sv = {2, 2, 2, 2};
+    migraphx::shape zs{migraphx::shape::fp8e4m3fnuz_type, {4}};
+    std::vector<fp8e4m3fnuz> zv(4, fp8e4m3fnuz{0.0f});
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(xs, xv);
+    auto s   = mm->add_literal(ss, sv);
+    auto z   = mm->add_literal(zs, zv);
+    mm->add_instruction(migraphx::make_op("quantizelinear"), x, s, z);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    // fp8 outputs are not rounded to integers and saturate to the largest finite value
+    std::vector<float> gold{
+        float{fp8e4m3fnuz{0.65f}}, float{fp8e4m3fnuz{-1.3f}}, 240.0f, -240.0f};
+    EXPECT(results_vector == gold);
+}
@@ -0,0 +1,162 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <numeric>
+
+#include <test.hpp>
+
+static std::vector<float> run_resize(const migraphx::shape& s,
+                                     const std::vector<float>& data,
+                                     const migraphx::value& v,
+                                     bool transpose = false)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(migraphx::literal{s, data});
+    if(transpose)
+        x = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 1, 3, 2}}}),
+                                x);
+    mm->add_instruction(migraphx::make_op("resize", v), x);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+TEST_CASE(resize_nearest_upsample_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto result = run_resize(s, {1, 2, 3, 4}, {{"scales", {1.0, 1.0, 2.0, 3.0}}});
+    std::vector<float> gold = {1, 1, 1, 2, 2, 2, 1, 1, 1, 2, 2, 2,
+                               3, 3, 3, 4, 4, 4, 3, 3, 3, 4, 4, 4};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(resize_nearest_downsample_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 4}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0.0f);
+    auto result = run_resize(s,
+                             data,
+                             {{"scales", {1.0, 1.0, 0.6, 0.6}},
+                              {"coordinate_transformation_mode", "align_corners"},
+                              {"nearest_mode", "floor"}});
+    std::vector<float> gold = {0.0f, 3.0f};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(resize_nearest_transposed_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto result = run_resize(s, {1, 3, 2, 4}, {{"scales", {1.0, 1.0, 2.0, 3.0}}}, true);
+    std::vector<float> gold = {1, 1, 1, 2, 2, 2, 1, 1, 1, 2, 2, 2,
+                               3, 3, 3, 4, 4, 4, 3, 3, 3, 4, 4, 4};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(resize_linear_upsample_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto result =
+        run_resize(s, {1, 2, 3, 4}, {{"scales", {1.0, 1.0, 2.0, 2.0}}, {"mode", "linear"}});
+    std::vector<float> gold = {
+        1, 1.25, 1.75, 2, 1.5, 1.75, 2.25, 2.5, 2.5, 2.75, 3.25, 3.5, 3, 3.25, 3.75, 4};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(resize_linear_align_corners_sizes_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto result = run_resize(s,
+                             {1, 2, 3, 4},
+                             {{"sizes", {1, 1, 4, 4}},
+                              {"mode", "linear"},
+                              {"coordinate_transformation_mode", "align_corners"}});
+    std::vector<float> gold = {1,
+                               4.0f / 3,
+                               5.0f / 3,
+                               2,
+                               5.0f / 3,
+                               2,
+                               7.0f / 3,
+                               8.0f / 3,
+                               7.0f / 3,
+                               8.0f / 3,
+                               3,
+                               10.0f / 3,
+                               3,
+                               10.0f / 3,
+                               11.0f / 3,
+                               4};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(resize_cubic_upsample_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 4, 4}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 1.0f);
+    auto result = run_resize(s, data, {{"scales", {1.0, 1.0, 2.0, 2.0}}, {"mode", "cubic"}});
+    std::vector<float> gold = {
+        0.47265625, 0.76953125, 1.2460938, 1.875,     2.28125,   2.9101562, 3.3867188, 3.6835938,
+        1.6601562,  1.9570312,  2.4335938, 3.0625,    3.46875,   4.0976562, 4.5742188, 4.8710938,
+        3.5664062,  3.8632812,  4.3398438, 4.96875,   5.375,     6.0039062, 6.4804688, 6.7773438,
+        6.0820312,  6.3789062,  6.8554688, 7.484375,  7.890625,  8.5195312, 8.9960938, 9.2929688,
+        7.7070312,  8.0039062,  8.4804688, 9.109375,  9.515625,  10.144531, 10.621094, 10.917969,
+        10.222656,  10.519531,  10.996094, 11.625,    12.03125,  12.660156, 13.136719, 13.433594,
+        12.128906,  12.425781,  12.902344, 13.53125,  13.9375,   14.566406, 15.042969, 15.339844,
+        13.316406,  13.613281,  14.089844, 14.71875,  15.125,    15.753906, 16.230469, 16.527344};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(resize_cubic_exclude_outside_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 4, 4}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 1.0f);
+    auto result = run_resize(s,
+                             data,
+                             {{"scales", {1.0, 1.0, 2.0, 2.0}},
+                              {"mode", "cubic"},
+                              {"cubic_coeff_a", -0.5},
+                              {"exclude_outside", true}});
+    std::vector<float> gold = {
+        0.55882353, 0.81494204, 1.3569825, 1.8970588, 2.3970588, 2.9371352, 3.4791756, 3.7352941,
+        1.5832976,  1.8394161,  2.3814565, 2.9215328, 3.4215328, 3.9616092, 4.5036496, 4.7597681,
+        3.7514594,  4.0075779,  4.5496183, 5.0896947, 5.5896947, 6.129771,  6.6718114, 6.92793,
+        5.9117647,  6.1678832,  6.7099237, 7.25,      7.75,      8.2900763, 8.8321168, 9.0882353,
+        7.9117647,  8.1678832,  8.7099237, 9.25,      9.75,      10.290076, 10.832117, 11.088235,
+        10.07207,   10.328189,  10.870229, 11.410305, 11.910305, 12.450382, 12.992422, 13.248541,
+        12.240232,  12.49635,   13.038391, 13.578467, 14.078467, 14.618543, 15.160584, 15.416702,
+        13.264706,  13.520824,  14.062865, 14.602941, 15.102941, 15.643018, 16.185058, 16.441176};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
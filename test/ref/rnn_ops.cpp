@@ -21,12 +21,15 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <migraphx/generate.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/op/common.hpp>
+#include <migraphx/pass_manager.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/rewrite_rnn.hpp>
 #include <migraphx/verify.hpp>
 
 #include "test.hpp"
@@ -3946,6 +3949,73 @@ TEST_CASE(gru_fp16)
         hs_data, migraphx::verify::expected{hs_data_gold}, migraphx::verify::tolerance{0.005}));
 }
 
+TEST_CASE(gru_bidirectional_var_seq_lens_unrolled)
+{
+    std::size_t batch_size  = 3;
+    std::size_t seq_len     = 5;
+    std::size_t hidden_size = 4;
+    std::size_t input_size  = 3;
+    std::size_t num_dirct   = 2;
+    migraphx::shape in_shape{migraphx::shape::float_type, {seq_len, batch_size, input_size}};
+    migraphx::shape w_shape{migraphx::shape::float_type,
+                            {num_dirct, 3 * hidden_size, input_size}};
+    migraphx::shape r_shape{migraphx::shape::float_type,
+                            {num_dirct, 3 * hidden_size, hidden_size}};
+    migraphx::shape b_shape{migraphx::shape::float_type, {num_dirct, 6 * hidden_size}};
+    migraphx::shape ih_shape{migraphx::shape::float_type, {num_dirct, batch_size, hidden_size}};
+    migraphx::shape sl_shape{migraphx::shape::int32_type, {batch_size}};
+    std::vector<int32_t> sl_data{5, 2, 3};
+
+    for(int linear_before_reset : {0, 1})
+    {
+        migraphx::program p;
+        auto* mm  = p.get_main_module();
+        auto seq  = mm->add_literal(migraphx::generate_literal(in_shape, 0));
+        auto w    = mm->add_literal(migraphx::generate_literal(w_shape, 1));
+        auto r    = mm->add_literal(migraphx::generate_literal(r_shape, 2));
+        auto bias = mm->add_literal(migraphx::generate_literal(b_shape, 3));
+        auto sql  = mm->add_literal(migraphx::literal{sl_shape, sl_data});
+        auto ih   = mm->add_literal(migraphx::generate_literal(ih_shape, 4));
+        auto hs   = mm->add_instruction(
+            migraphx::make_op(
+                "gru",
+                {{"hidden_size", hidden_size},
+                 {"actv_func",
+                  migraphx::to_value(std::vector<migraphx::operation>{
+                      migraphx::make_op("sigmoid"), migraphx::make_op("tanh")})},
+                 {"direction", migraphx::to_value(migraphx::op::rnn_direction::bidirectional)},
+                 {"linear_before_reset", linear_before_reset}}),
+            seq,
+            w,
+            r,
+            bias,
+            sql,
+            ih);
+        auto lho = mm->add_instruction(migraphx::make_op("rnn_last_hs_output"), hs);
+        mm->add_return({hs, lho});
+
+        // The ref target evaluates the gru without unrolling it
+        migraphx::program unrolled = p;
+        migraphx::run_passes(unrolled, {migraphx::rewrite_rnn{}});
+        EXPECT(std::none_of(unrolled.get_main_module()->begin(),
+                            unrolled.get_main_module()->end(),
+                            [](const auto& ins) { return ins.name() == "gru"; }));
+        p.compile(migraphx::make_target("ref"));
+        unrolled.compile(migraphx::make_target("ref"));
+        auto outputs          = p.eval({});
+        auto unrolled_outputs = unrolled.eval({});
+        EXPECT(outputs.size() == unrolled_outputs.size());
+        for(std::size_t i = 0; i < outputs.size(); i++)
+        {
+            std::vector<float> result;
+            std::vector<float> gold;
+            outputs[i].visit([&](auto output) { result.assign(output.begin(), output.end()); });
+            unrolled_outputs[i].visit([&](auto output) { gold.assign(output.begin(), output.end()); });
+            EXPECT(migraphx::verify::verify_rms_range(result, gold));
+        }
+    }
+}
+
 TEST_CASE(lstm_forward)
 {
     std::size_t batch_size  = 3;
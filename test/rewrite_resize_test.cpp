@@ -0,0 +1,103 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/rewrite_resize.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/verify.hpp>
+#include <test.hpp>
+
+static void opt_resize(migraphx::module& m)
+{
+    migraphx::rewrite_resize rr;
+    migraphx::dead_code_elimination dce;
+    rr.apply(m);
+    dce.apply(m);
+}
+
+static std::vector<float>
+eval_resize(const migraphx::shape& s, const migraphx::value& v, bool rewrite)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(migraphx::generate_literal(s));
+    mm->add_instruction(migraphx::make_op("resize", v), x);
+    if(rewrite)
+    {
+        opt_resize(*mm);
+        EXPECT(none_of(*mm, [](const auto& ins) { return ins.name() == "resize"; }));
+    }
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+static void check_rewrite(const migraphx::shape& s, const migraphx::value& v)
+{
+    auto gold   = eval_resize(s, v, false);
+    auto result = eval_resize(s, v, true);
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(rewrite_resize_nearest)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 2, 3, 4}};
+    check_rewrite(s, {{"scales", {1.0, 1.0, 2.0, 3.0}}});
+    check_rewrite(s,
+                  {{"scales", {1.0, 1.0, 0.6, 0.6}},
+                   {"coordinate_transformation_mode", "asymmetric"},
+                   {"nearest_mode", "ceil"}});
+    check_rewrite(s,
+                  {{"sizes", {1, 2, 5, 7}},
+                   {"coordinate_transformation_mode", "tf_half_pixel_for_nn"},
+                   {"nearest_mode", "round_prefer_ceil"}});
+}
+
+TEST_CASE(rewrite_resize_linear)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 2, 3, 4}};
+    check_rewrite(s, {{"scales", {1.0, 1.0, 2.0, 2.0}}, {"mode", "linear"}});
+    check_rewrite(s, {{"scales", {1.0, 1.0, 0.6, 0.5}}, {"mode", "linear"}});
+    check_rewrite(s,
+                  {{"sizes", {1, 2, 5, 7}},
+                   {"mode", "linear"},
+                   {"coordinate_transformation_mode", "align_corners"}});
+}
+
+TEST_CASE(rewrite_resize_cubic)
+{
+    migraphx::module m;
+    auto x = m.add_parameter("x", {migraphx::shape::float_type, {1, 1, 2, 2}});
+    m.add_instruction(
+        migraphx::make_op("resize", {{"scales", {1.0, 1.0, 2.0, 2.0}}, {"mode", "cubic"}}), x);
+    EXPECT(test::throws([&] { opt_resize(m); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
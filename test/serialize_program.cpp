@@ -26,6 +26,7 @@
 #include <migraphx/load_save.hpp>
 #include "test.hpp"
 #include <migraphx/make_op.hpp>
+#include <migraphx/instruction.hpp>
 
 #include <cstdio>
 
@@ -88,6 +89,36 @@ TEST_CASE(compiled)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(duplicate_literals)
+{
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+        auto a   = mm->add_literal(2);
+        auto b   = mm->add_literal(2);
+        auto c   = mm->add_literal(3);
+        auto add = mm->add_instruction(migraphx::make_op("add"), x, a);
+        auto mul = mm->add_instruction(migraphx::make_op("mul"), add, b);
+        auto sub = mm->add_instruction(migraphx::make_op("sub"), mul, c);
+        mm->add_return({sub});
+    }
+    auto v = p1.to_value();
+    EXPECT(v.at("literals").size() == 2);
+    migraphx::program p2;
+    p2.from_value(v);
+    EXPECT(p1.sort() == p2.sort());
+
+    auto* mm = p2.get_main_module();
+    auto sub = std::prev(mm->end())->inputs().front();
+    auto mul = sub->inputs().front();
+    auto add = mul->inputs().front();
+    EXPECT(mul->inputs().back()->get_literal().shares_buffer(
+        add->inputs().back()->get_literal()));
+    EXPECT(not sub->inputs().back()->get_literal().shares_buffer(
+        add->inputs().back()->get_literal()));
+}
+
 TEST_CASE(unknown_format)
 {
     migraphx::file_options options;
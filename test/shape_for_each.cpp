@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/shape_for_each.hpp>
+#include <atomic>
+#include "test.hpp"
+
+TEST_CASE(shape_for_each_order)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3, 4, 5}};
+    std::size_t n = 0;
+    migraphx::shape_for_each(s, [&](const auto& idx, std::size_t i) {
+        EXPECT(i == n);
+        EXPECT(idx == s.multi(i));
+        n++;
+    });
+    EXPECT(n == s.elements());
+}
+
+TEST_CASE(shape_for_each_scalar)
+{
+    migraphx::shape s{migraphx::shape::float_type};
+    std::size_t n = 0;
+    migraphx::shape_for_each(s, [&](const auto& idx) {
+        EXPECT(idx.size() == 1);
+        n++;
+    });
+    EXPECT(n == 1);
+}
+
+TEST_CASE(shape_for_each_empty)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 0, 3}};
+    std::size_t n = 0;
+    migraphx::shape_for_each(s, [&](const auto&) { n++; });
+    migraphx::par_shape_for_each(s, 1, [&](const auto&) { n++; });
+    EXPECT(n == 0);
+}
+
+TEST_CASE(par_shape_for_each_all_indices)
+{
+    migraphx::shape s{migraphx::shape::float_type, {7, 13, 11}};
+    std::vector<std::atomic<std::size_t>> visits(s.elements());
+    migraphx::par_shape_for_each(s, 16, [&](const auto& idx, std::size_t i) {
+        EXPECT(idx == s.multi(i));
+        visits[i]++;
+    });
+    EXPECT(std::all_of(visits.begin(), visits.end(), [](const auto& v) { return v == 1; }));
+}
+
+TEST_CASE(shape_for_each_offset_strides)
+{
+    std::vector<std::size_t> lens = {3, 4, 5, 6};
+    migraphx::shape s1{migraphx::shape::float_type, lens};
+    auto s2 = migraphx::shape::from_permutation(migraphx::shape::float_type, lens, {0, 2, 3, 1});
+    migraphx::shape s3{migraphx::shape::float_type, lens, {0, 1, 0, 4}};
+    std::size_t n = 0;
+    migraphx::shape_for_each_offset({s1, s2, s3}, [&](const auto& idx, const auto& offsets) {
+        EXPECT(offsets.size() == 3);
+        EXPECT(offsets[0] == s1.index(idx));
+        EXPECT(offsets[1] == s2.index(idx));
+        EXPECT(offsets[2] == s3.index(idx));
+        n++;
+    });
+    EXPECT(n == s1.elements());
+}
+
+TEST_CASE(par_shape_for_each_offset_strides)
+{
+    std::vector<std::size_t> lens = {5, 9, 17};
+    migraphx::shape s1{migraphx::shape::float_type, lens};
+    migraphx::shape s2{migraphx::shape::float_type, lens, {1, 5, 45}};
+    std::vector<std::atomic<std::size_t>> visits(s1.elements());
+    migraphx::par_shape_for_each_offset({s1, s2}, 8, [&](const auto& idx, const auto& offsets) {
+        EXPECT(offsets[1] == s2.index(idx));
+        visits[offsets[0]]++;
+    });
+    EXPECT(std::all_of(visits.begin(), visits.end(), [](const auto& v) { return v == 1; }));
+}
+
+TEST_CASE(shape_odometer_seek)
+{
+    std::vector<std::size_t> lens = {4, 3, 5};
+    migraphx::shape s{migraphx::shape::float_type, lens, {1, 20, 4}};
+    migraphx::shape_odometer it{lens, {s.strides()}, 17};
+    for(std::size_t i = 17; i < s.elements(); i++, ++it)
+    {
+        migraphx::shape_odometer seeked{lens, {s.strides()}, i};
+        EXPECT(it.index() == seeked.index());
+        EXPECT(it.offset(0) == s.index(it.index()));
+    }
+}
+
+TEST_CASE(par_shape_for_each_row_broadcast)
+{
+    std::vector<std::size_t> lens = {4, 6, 5, 7};
+    migraphx::shape s1{migraphx::shape::float_type, lens};
+    migraphx::shape s2{migraphx::shape::float_type, lens, {0, 1, 0, 0}};
+    std::vector<std::atomic<std::size_t>> visits(s1.elements());
+    migraphx::par_shape_for_each_row(
+        {s1, s2}, 8, [&](const auto& offsets, std::size_t n, const auto& strides) {
+            EXPECT(strides[0] == 1);
+            EXPECT(strides[1] == 0);
+            for(std::size_t j = 0; j < n; j++)
+            {
+                auto i = offsets[0] + j;
+                EXPECT(offsets[1] == s2.index(s1.multi(i)));
+                visits[i]++;
+            }
+        });
+    EXPECT(std::all_of(visits.begin(), visits.end(), [](const auto& v) { return v == 1; }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -346,6 +346,45 @@ TEST_CASE(value_construct_object)
     EXPECT(v["three"].get_key() == "three");
 }
 
+TEST_CASE(value_large_object)
+{
+    migraphx::value v = migraphx::value::object{};
+    for(int i = 0; i < 64; i++)
+        v["k" + std::to_string(i)] = i;
+    EXPECT(v.is_object());
+    EXPECT(v.size() == 64);
+    EXPECT(v.front().get_key() == "k0");
+    EXPECT(v.back().get_key() == "k63");
+    for(int i = 0; i < 64; i++)
+    {
+        EXPECT(v.contains("k" + std::to_string(i)));
+        EXPECT(v.at("k" + std::to_string(i)).get_int64() == i);
+    }
+    EXPECT(not v.contains("k64"));
+
+    auto p = v.insert({"k7", 100});
+    EXPECT(not p.second);
+    EXPECT(p.first->get_int64() == 7);
+    EXPECT(v.size() == 64);
+
+    migraphx::value c = v;
+    c["k64"]          = 64;
+    EXPECT(c.size() == 65);
+    EXPECT(c.at("k64").get_int64() == 64);
+    EXPECT(c.at("k32").get_int64() == 32);
+    EXPECT(not v.contains("k64"));
+    EXPECT(c != v);
+}
+
+TEST_CASE(value_object_duplicate_keys)
+{
+    std::vector<migraphx::value> values = {{"a", 1}, {"b", 2}, {"a", 3}};
+    migraphx::value v(values);
+    EXPECT(v.is_object());
+    EXPECT(v.at("a").get_int64() == 3);
+    EXPECT(v.at("b").get_int64() == 2);
+}
+
 TEST_CASE(value_key_object)
 {
     std::unordered_map<std::string, migraphx::value> values = {
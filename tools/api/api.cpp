@@ -147,6 +147,13 @@ void set_exhaustive_tune_flag(compile_options& options, bool value)
     options.exhaustive_tune = value;
 }
 
+void set_cache_dir(compile_options& options, const char* dir) { options.cache_dir = dir; }
+
+void set_cache_max_size(compile_options& options, size_t value)
+{
+    options.cache_max_bytes = value;
+}
+
 void set_file_format(file_options& options, const char* format) { options.format = format; }
 
 void set_default_dim_value(onnx_options& options, size_t value)